@@ -0,0 +1,17 @@
+#version 330 core
+
+layout(location = 0) in vec2 position;
+// Per instance attributes, the origin and size of the particle in screen space and its texture coordinates
+layout(location = 1) in vec4 rect;
+layout(location = 2) in vec4 texRect;
+
+out vec2 vTexCoord;
+
+mat4 ortho(float left, float right, float bottom, float top) {
+    return mat4(vec4(2.0 / (right - left), 0, 0, 0), vec4(0, 2.0 / (top - bottom), 0, 0), vec4(0, 0, -1, 0), vec4(-(right + left) / (right - left), -(top + bottom) / (top - bottom), 0, 1));
+}
+
+void main() {
+    gl_Position = ortho(0, 1280, 0, 720) * vec4(rect.xy + position * rect.zw, 0.0, 1.0);
+    vTexCoord = mix(texRect.xy, texRect.zw, position);
+}
@@ -1,7 +1,9 @@
 #version 330 core
 
 layout(location = 0) in vec4 position;
+layout(location = 1) in vec3 colour;
 out vec2 texCoord;
+out vec3 textColour;
 
 mat4 ortho(float left, float right, float bottom, float top) {
     return mat4(vec4(2.0 / (right - left), 0, 0, 0), vec4(0, 2.0 / top - bottom, 0, 0), vec4(0, 0, -1, 0), vec4(-(right + left) / (right - left), -(top + bottom) / (top - bottom), 0, 1));
@@ -10,4 +12,5 @@ mat4 ortho(float left, float right, float bottom, float top) {
 void main() {
     gl_Position = ortho(0, 1280, 0, 720) * vec4(position.xy, 0, 1);
     texCoord = position.zw;
+    textColour = colour;
 }
\ No newline at end of file
@@ -5,15 +5,16 @@ AnimatedSprite::AnimatedSprite(const std::string & path, int frame_w, int frame_
 	Sprite(path),
 	counter(0),
 	frame_index(0),
-	animation_index(0)
+	animation_index(0),
+	last_tick(Core::getSimTicks())
 {
 	// Set the source w/h to be the same as an animation frame
 	src_w = frame_w;
 	src_h = frame_h;
 
 	// Calculate the number of sprites in the sprite sheet based on the input frame size and texture size
-	spriteSheetWidth = Core::getTexture(path)->getWidth() / frame_w;
-	spriteSheetHeight = Core::getTexture(path)->getHeight() / frame_h;
+	spriteSheetWidth = original_w / frame_w;
+	spriteSheetHeight = original_h / frame_h;
 }
 
 AnimatedSprite::~AnimatedSprite() {
@@ -22,30 +23,7 @@ AnimatedSprite::~AnimatedSprite() {
 
 void AnimatedSprite::render()
 {
-	// Only update the frame if the timer is up
-	// TODO: switch this to use a timer instead of tick counting
-	if (counter < 2) {
-		counter++;
-	} else {
-		counter = 0;
-		frame_index++;
-		if (frame_index > frames[animation_index].y()) {
-			// Determine if we are done with the current animation state
-			if (!animations.empty()) {
-				animations.front().loops--;
-				// If we have no loops left, remove the animation state from the sprite
-				if (animations.front().loops == 0) {
-					animations.pop();
-				}
-				// If there is still an animtion state left, use that as the new animation index
-				if (!animations.empty()) animation_index = animations.front().animation_index;
-			}
-			frame_index = frames[animation_index].x();
-		}
-
-		// Update the sprite source to the correct animation frame
-		updateSourcePosFromFrame();
-	}
+	updateFrame();
 
 	// Actually draw the sprite
 	Core::Renderer::drawSprite(*this);
@@ -61,8 +39,20 @@ void AnimatedSprite::addAnimation(unsigned int start, unsigned int end) {
 }
 
 void AnimatedSprite::updateFrame() {
+	// Advance once for every simulation tick since the last update so the animation
+	// speed doesn't depend on how often the sprite is rendered
+	unsigned int tick = Core::getSimTicks();
+	unsigned int elapsed = tick - last_tick;
+	last_tick = tick;
+	// Sprites that haven't been rendered in a while continue where they left off
+	if (elapsed > ANIMATION_MAX_CATCHUP_TICKS) elapsed = ANIMATION_MAX_CATCHUP_TICKS;
+	for (unsigned int i = 0; i < elapsed; ++i) {
+		stepFrame();
+	}
+}
+
+void AnimatedSprite::stepFrame() {
 	// Only update the frame if the timer is up
-	// TODO: switch this to use a timer instead of tick counting
 	if (counter < 2) {
 		counter++;
 	} else {
@@ -6,6 +6,9 @@
 #include "../math/vec.hpp"
 #include "sprite.hpp"
 
+// The most simulation ticks an animation will catch up on in a single update
+#define ANIMATION_MAX_CATCHUP_TICKS	4
+
 // Structure to represent a queued animation
 struct AnimationState {
 	unsigned int animation_index;
@@ -39,6 +42,11 @@ private:
 	int counter;
 	unsigned int frame_index;
 	unsigned int animation_index;
+	// The simulation tick the animation was last updated on
+	unsigned int last_tick;
+
+	// Advance the animation by a single simulation tick
+	void stepFrame();
 
 	// Helper function to calculate animation frame coordinates
 	void updateSourcePosFromFrame();
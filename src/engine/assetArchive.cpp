@@ -0,0 +1,173 @@
+#include "assetArchive.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _DEBUG
+#define LOG(x) std::cout << x << std::endl
+#else
+#define LOG(x)
+#endif
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetArchive::AssetArchive() :
+	m_data(nullptr),
+	m_size(0),
+#ifdef _WIN32
+	m_file(INVALID_HANDLE_VALUE),
+	m_mapping(nullptr)
+#else
+	m_file(-1)
+#endif
+{
+
+}
+
+AssetArchive::~AssetArchive() {
+	close();
+}
+
+bool AssetArchive::open(const std::string & path) {
+	close();
+
+#ifdef _WIN32
+	m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+		close();
+		return false;
+	}
+	m_size = static_cast<size_t>(size.QuadPart);
+	m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_mapping) {
+		close();
+		return false;
+	}
+	m_data = static_cast<const unsigned char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+	m_file = ::open(path.c_str(), O_RDONLY);
+	if (m_file < 0) return false;
+	struct stat info;
+	if (fstat(m_file, &info) != 0 || info.st_size == 0) {
+		close();
+		return false;
+	}
+	m_size = static_cast<size_t>(info.st_size);
+	void * data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+	m_data = data == MAP_FAILED ? nullptr : static_cast<const unsigned char*>(data);
+#endif
+	if (!m_data) {
+		close();
+		return false;
+	}
+
+	// Validate the header before trusting any of the records
+	AssetArchiveHeader header;
+	if (m_size < sizeof(header)) {
+		close();
+		return false;
+	}
+	std::memcpy(&header, m_data, sizeof(header));
+	if (std::memcmp(header.magic, ASSET_ARCHIVE_MAGIC, 4) != 0 || header.version != ASSET_ARCHIVE_VERSION) {
+		std::cerr << "Ignoring asset archive with an unknown format: " << path << std::endl;
+		close();
+		return false;
+	}
+
+	size_t position = sizeof(header);
+	for (uint32_t i = 0; i < header.count; ++i) {
+		AssetArchiveRecord record;
+		if (position + sizeof(record) > m_size) break;
+		std::memcpy(&record, m_data + position, sizeof(record));
+		position += sizeof(record);
+		if (position + record.pathLength > m_size || record.offset + record.size > m_size) break;
+
+		std::string assetPath(reinterpret_cast<const char*>(m_data + position), record.pathLength);
+		position += record.pathLength;
+		m_assets[assetPath] = AssetView{ m_data + record.offset, static_cast<size_t>(record.size),
+			static_cast<AssetType>(record.type), record.width, record.height };
+	}
+	if (m_assets.size() != header.count) {
+		std::cerr << "Ignoring truncated asset archive: " << path << std::endl;
+		close();
+		return false;
+	}
+
+	LOG("Mapped " << m_assets.size() << " assets from " << path);
+	return true;
+}
+
+void AssetArchive::close() {
+	// Workers may still be reading from the mapping
+	for (auto& preloaded : m_preloaded) {
+		preloaded.second.wait();
+	}
+	m_preloaded.clear();
+	m_assets.clear();
+#ifdef _WIN32
+	if (m_data) UnmapViewOfFile(m_data);
+	if (m_mapping) CloseHandle(m_mapping);
+	if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+	m_mapping = nullptr;
+	m_file = INVALID_HANDLE_VALUE;
+#else
+	if (m_data) munmap(const_cast<unsigned char*>(m_data), m_size);
+	if (m_file >= 0) ::close(m_file);
+	m_file = -1;
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
+
+const AssetView * AssetArchive::find(const std::string & path) const {
+	auto it = m_assets.find(path);
+	if (it == m_assets.end()) return nullptr;
+	return &it->second;
+}
+
+bool AssetArchive::loadJson(const std::string & path, nlohmann::json & data) {
+	auto it = m_preloaded.find(path);
+	if (it != m_preloaded.end()) {
+		std::pair<bool, nlohmann::json> result = it->second.get();
+		m_preloaded.erase(it);
+		data = std::move(result.second);
+		return result.first;
+	}
+	return readJson(path, data);
+}
+
+void AssetArchive::preloadJson(const std::vector<std::string>& paths) {
+	for (const std::string& path : paths) {
+		if (m_preloaded.find(path) != m_preloaded.end()) continue;
+		m_preloaded[path] = std::async(std::launch::async, [this, path]() {
+			std::pair<bool, nlohmann::json> result;
+			result.first = readJson(path, result.second);
+			return result;
+		});
+	}
+}
+
+bool AssetArchive::readJson(const std::string & path, nlohmann::json & data) const {
+	const AssetView * asset = find(path);
+	if (asset && asset->type == AssetType::DATA) {
+		data = nlohmann::json::from_msgpack(asset->data, asset->data + asset->size);
+		return true;
+	}
+
+	std::ifstream file(path);
+	if (!file.is_open()) return false;
+	file >> data;
+	return true;
+}
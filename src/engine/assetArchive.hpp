@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+// Archive written by tools/assetPacker, memory mapped on startup if it exists
+#define ASSET_ARCHIVE_FILE		"res/assets.pak"
+#define ASSET_ARCHIVE_MAGIC		"WNPK"
+#define ASSET_ARCHIVE_VERSION	1
+// Every asset starts on a multiple of this so pixel data can be handed straight to OpenGL
+#define ASSET_ARCHIVE_ALIGNMENT	16
+
+enum class AssetType : uint32_t {
+	// Raw RGBA pixels, already flipped to the bottom up order OpenGL expects
+	TEXTURE,
+	// A json file stored as MessagePack, which parses without any text handling
+	DATA
+};
+
+// Layout of the archive file, shared with the packer
+//	header | records, each followed by its path | aligned asset data
+struct AssetArchiveHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t count;
+	uint32_t reserved;
+};
+struct AssetArchiveRecord {
+	uint64_t offset;
+	uint64_t size;
+	uint32_t type;
+	int32_t width, height;
+	uint32_t pathLength;
+};
+
+// A view into the mapped archive, valid for as long as the archive stays open
+struct AssetView {
+	const unsigned char * data;
+	size_t size;
+	AssetType type;
+	int width, height;
+};
+
+/*	Read only access to the packed asset archive
+		- The whole archive is memory mapped, so assets are read straight from the
+			mapping without copying them or decoding anything
+		- Paths are the same ones the game uses for the loose files, anything missing from
+			the archive (or every file when there is no archive) is read from disk instead
+		- Files the game writes, like saves, are never packed
+		- Data files can be preloaded on worker threads during startup, loading a preloaded
+			file only waits for its worker instead of reading it again
+*/
+class AssetArchive {
+
+public:
+	// Accessor method for singleton pattern
+	static AssetArchive& get_instance() {
+		static AssetArchive archive;
+		return archive;
+	}
+
+	// Delete copy and move constructors and assign operators
+	AssetArchive(AssetArchive const&) = delete;             // Copy construct
+	AssetArchive(AssetArchive&&) = delete;                  // Move construct
+	AssetArchive& operator=(AssetArchive const&) = delete;  // Copy assign
+	AssetArchive& operator=(AssetArchive &&) = delete;      // Move assign
+
+	bool open(const std::string& path);
+	void close();
+	inline bool isOpen() const { return m_data != nullptr; }
+
+	// The packed asset of a path or nullptr if it isn't in the archive
+	const AssetView* find(const std::string& path) const;
+	// Load a data file from the archive, or parse the loose json file if it isn't packed
+	bool loadJson(const std::string& path, nlohmann::json& data);
+	// Start parsing data files on worker threads, has to be called after the archive is opened
+	void preloadJson(const std::vector<std::string>& paths);
+
+private:
+	AssetArchive();
+	~AssetArchive();
+
+	// Only reads the mapping, so any thread can call it
+	bool readJson(const std::string& path, nlohmann::json& data) const;
+
+	std::unordered_map<std::string, AssetView> m_assets;
+	// Data files that are being parsed in the background, along with whether they could be read
+	std::unordered_map<std::string, std::future<std::pair<bool, nlohmann::json>>> m_preloaded;
+
+	// The mapping of the archive file
+	const unsigned char * m_data;
+	size_t m_size;
+#ifdef _WIN32
+	void * m_file;
+	void * m_mapping;
+#else
+	int m_file;
+#endif
+};
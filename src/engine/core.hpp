@@ -9,12 +9,20 @@
 #include "entity.hpp"
 #include "state.hpp"
 #include "sprite.hpp"
+#include "spriteMesh.hpp"
+#include "profiler.hpp"
+#include "assetArchive.hpp"
+#include "particleWorkers.hpp"
 
 // Wrappers around core engine functionalities
 namespace Core {
 
-	inline bool init(const char * name, int window_width, int window_height) {
-		return Engine::get_instance().init(name, window_width, window_height);
+	inline bool init(const char * name, int window_width, int window_height, bool headless = false) {
+		return Engine::get_instance().init(name, window_width, window_height, headless);
+	}
+
+	inline bool isHeadless() {
+		return Engine::get_instance().isHeadless();
 	}
 
 	inline void setState(State * state) {
@@ -41,40 +49,134 @@ namespace Core {
 		return Engine::get_instance().getTicks()/1000.0f;
 	}
 
+	inline void setTickRate(int tickRate) {
+		Engine::get_instance().setTickRate(tickRate);
+	}
+
+	// Particle systems with at least this many particles are updated on every core
+	inline void setParticleThreshold(size_t count) {
+		ParticleWorkers::get_instance().setThreshold(count);
+	}
+
+	inline unsigned int getSimTicks() {
+		return Engine::get_instance().getSimTicks();
+	}
+
+	inline float getInterpolation() {
+		return Engine::get_instance().getInterpolation();
+	}
+
+	inline void setFramePolicy(FramePolicy policy) {
+		Engine::get_instance().setFramePolicy(policy);
+	}
+
+	inline void setFrameRate(int frameRate) {
+		Engine::get_instance().setFrameRate(frameRate);
+	}
+
 	inline void setDebugMode(bool mode) {
 		Engine::get_instance().setDebugMode(mode);
 	}
 
-	inline bool getdebugMode(bool mode) {
+	inline bool getDebugMode() {
 		return Engine::get_instance().getDebugMode();
 	}
 
+	inline void addDebugText(const std::string& text) {
+		Engine::get_instance().addDebugText(text);
+	}
+
+	inline bool writeProfile(const std::string& path) {
+		return Engine::get_instance().writeProfile(path);
+	}
+
+	// Read a data file from the asset archive, falling back to the loose file
+	inline bool loadJson(const std::string& path, nlohmann::json& data) {
+		return AssetArchive::get_instance().loadJson(path, data);
+	}
+
+	// Start parsing data files in the background so they are ready when they are first loaded
+	inline void preloadJson(const std::vector<std::string>& paths) {
+		AssetArchive::get_instance().preloadJson(paths);
+	}
+
 	inline Texture * getTexture(const std::string& fileName) {
 		return Engine::get_instance().getTextureManager()->getTexture(fileName);
 	}
 
+	inline TextureHandle getTextureHandle(const std::string& fileName) {
+		return Engine::get_instance().getTextureManager()->getHandle(fileName);
+	}
+
+	inline Texture * getTexture(TextureHandle handle) {
+		return Engine::get_instance().getTextureManager()->getTexture(handle);
+	}
+
+	inline const AtlasRegion * getAtlasRegion(const std::string& fileName) {
+		return Engine::get_instance().getTextureManager()->getRegion(fileName);
+	}
+
+	inline Vec2<int> getImageSize(const std::string& fileName) {
+		return Engine::get_instance().getTextureManager()->getImageSize(fileName);
+	}
+
+	inline Vec2<int> getImageSize(TextureHandle handle) {
+		return Engine::get_instance().getTextureManager()->getImageSize(handle);
+	}
+
+	inline void addTextureRef(TextureHandle handle) {
+		Engine::get_instance().getTextureManager()->addRef(handle);
+	}
+
+	inline void releaseTexture(TextureHandle handle) {
+		// Sprites may outlive the texture manager when the engine shuts down
+		TextureManager * textureManager = Engine::get_instance().getTextureManager();
+		if (textureManager) textureManager->release(handle);
+	}
+
+	inline void setTextureBudget(size_t bytes) {
+		Engine::get_instance().getTextureManager()->setMemoryBudget(bytes);
+	}
+
+	inline void prefetchTextures(const std::vector<std::string>& fileNames) {
+		Engine::get_instance().getTextureManager()->prefetch(fileNames);
+	}
+
 	// Wrappers around renderer functionalities
 	namespace Renderer {
 
-		inline void drawLine(ScreenCoord v1, ScreenCoord v2, Colour colour) {
-			Engine::get_instance().getRenderer()->drawLine_fast(v1, v2, colour);
+		// Draw any queued text first so it stays underneath whatever is drawn next
+		inline void flushText() {
+			Engine::get_instance().getTextRenderer()->flush();
+		}
+
+		inline void drawLine(ScreenCoord v1, ScreenCoord v2, Colour colour, float alpha = 1.f) {
+			flushText();
+			Engine::get_instance().getRenderer()->drawLine_fast(v1, v2, colour, alpha);
 		}
 
-		inline void drawRect(ScreenCoord v, int width, int height, Colour colour) {
-			Engine::get_instance().getRenderer()->drawRect_fast(v, width, height, colour);
+		inline void drawRect(ScreenCoord v, int width, int height, Colour colour, float alpha = 1.f) {
+			flushText();
+			Engine::get_instance().getRenderer()->drawRect_fast(v, width, height, colour, alpha);
 		}
 
 		inline void drawSprite(const Sprite& sprite) {
+			flushText();
 			Engine::get_instance().getRenderer()->drawSprite_fast(sprite);
 		}
 
-		inline void clear() {
-			Engine::get_instance().getRenderer()->clear();
+		inline void drawSpriteMesh(const SpriteMesh& mesh, const Texture& texture) {
+			flushText();
+			Engine::get_instance().getRenderer()->drawSpriteMesh(mesh, texture);
+		}
 
+		inline void drawParticles(const Texture& texture, const ParticleInstance * instances, unsigned int count) {
+			flushText();
+			Engine::get_instance().getRenderer()->drawParticles(texture, instances, count);
 		}
 
-		inline void setAlpha(float a) {
-			Engine::get_instance().getRenderer()->setAlpha(a);
+		inline void clear() {
+			Engine::get_instance().getRenderer()->clear();
 
 		}
 
@@ -84,6 +186,8 @@ namespace Core {
 	namespace Text_Renderer {
 
 		inline void render(std::string s, ScreenCoord pos, float scale = 1.f) {
+			// Draw any queued sprites first so the text ends up on top of them
+			Engine::get_instance().getRenderer()->flush();
 			Engine::get_instance().getTextRenderer()->render(s, pos, scale);
 		}
 
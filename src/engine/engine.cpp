@@ -7,19 +7,58 @@
 // Std library includes
 #include <iostream>
 #include <ctime>
+#include <future>
 
 // Other project includes
 #include "renderer.hpp"
 #include "text/textRenderer.hpp"
 #include "textureManager.hpp"
+#include "assetArchive.hpp"
 #include "state.hpp"
 #include "mixer.hpp"
+#include "headless.hpp"
+#include "profiler.hpp"
+#include "opengl/renderStats.hpp"
 
-bool Engine::init(const char * name, int window_width, int window_height) {
+bool Engine::init(const char * name, int window_width, int window_height, bool headless) {
+
+	PROFILE_SCOPE("Engine::init");
+	m_initCounter = SDL_GetPerformanceCounter();
 
 	// Set engine configuration variables
 	m_windowWidth = window_width;
 	m_windowHeight = window_height;
+	m_headless = headless;
+
+	if (m_headless) return initHeadless();
+
+	// Intialize SDL
+	if (SDL_Init(SDL_INIT_EVERYTHING) != 0) {
+		SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
+		// throw new std::exception("SDL failed to initialize");
+	}
+
+	// Work that doesn't need OpenGL runs on worker threads while the main thread creates the
+	// window and compiles shaders, the results are uploaded once the context exists
+	std::future<bool> archive = std::async(std::launch::async, []() {
+		PROFILE_SCOPE("AssetArchive::open");
+		return AssetArchive::get_instance().open(ASSET_ARCHIVE_FILE);
+	});
+	std::future<Font*> font = std::async(std::launch::async, []() {
+		PROFILE_SCOPE("Font::rasterize");
+		Font * result = new Font(ENGINE_FONT_FILE, ENGINE_FONT_SIZE);
+		result->rasterize(FONT_FIRST_CHARACTER, FONT_LAST_CHARACTER);
+		return result;
+	});
+	std::future<BaseMixer*> mixer = std::async(std::launch::async, []() -> BaseMixer* {
+		PROFILE_SCOPE("Mixer::open");
+		return new Mixer();
+	});
+	// If initialization fails, wait for the workers and free what they made, the mixer holds the audio device
+	auto discardWorkers = [&font, &mixer]() {
+		delete font.get();
+		delete mixer.get();
+	};
 
 	// Setup openGL attributes
 	SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
@@ -36,16 +75,18 @@ bool Engine::init(const char * name, int window_width, int window_height) {
 		SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE);
 	if (m_window == NULL) {
 		SDL_Log("Unable to create SDL window: %s", SDL_GetError());
+		discardWorkers();
 		return false;
 	}
 	m_context = SDL_GL_CreateContext(m_window);
 	if (m_context == NULL) {
 		SDL_Log("Unable to create openGL context: %s", SDL_GetError());
+		discardWorkers();
 		return false;
 	}
 
-	// Enable vsync
-	SDL_GL_SetSwapInterval(1);
+	// Sleep between frames by default instead of busy waiting
+	m_pacer.setPolicy(FramePolicy::SLEEP_SPIN);
 
 	// Setup blending
 	glEnable(GL_BLEND);
@@ -58,29 +99,68 @@ bool Engine::init(const char * name, int window_width, int window_height) {
 		std::cerr << "Error initializing GLEW: "
 			<< glewGetErrorString(glewError)
 			<< std::endl;
+		discardWorkers();
 		return false;
 	}
 
 	// Initialize the renderer after the OpenGL context is created
-	m_renderer = new Renderer();
+	{
+		PROFILE_SCOPE("Renderer::Renderer");
+		m_renderer = new Renderer();
+	}
 
-	// Initialize the text renderer after the OpenGL context is created
-	m_textRenderer = new TextRenderer("res/test_font.ttf", 32, Vec2<int>(m_windowWidth, m_windowHeight));
+	// Upload the glyphs rasterized in the background
+	{
+		PROFILE_SCOPE("TextRenderer::TextRenderer");
+		Font * rasterized = font.get();
+		m_textRenderer = new TextRenderer(*rasterized, Vec2<int>(m_windowWidth, m_windowHeight));
+		delete rasterized;
+	}
 
-	// Initialize the texture manager
+	// Initialize the texture manager once the asset archive is mapped (if it was built),
+	// packed images are drawn from the atlas if it was built
+	archive.wait();
 	m_textureManager = new TextureManager();
+	m_textureManager->loadAtlas(ATLAS_FILE);
 
-	// Initialize the mixer
-	m_mixer = new Mixer();
+	m_mixer = mixer.get();
 
 	// reset m_lastTick for a more accurate first tick
 	m_lastTick = SDL_GetTicks();
+	m_lastCounter = SDL_GetPerformanceCounter();
 
 	mac_fix = 0;
 
 	// Seed random
 	srand(static_cast<unsigned int>(time(0)));
-	
+
+	m_initTime = static_cast<double>(SDL_GetPerformanceCounter() - m_initCounter) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	return true;
+}
+
+bool Engine::initHeadless() {
+	// Only the subsystems that don't need a display are initialized
+	if (SDL_Init(SDL_INIT_TIMER | SDL_INIT_EVENTS) != 0) {
+		SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
+		return false;
+	}
+	m_window = nullptr;
+	m_context = nullptr;
+
+	// Use the null backends so nothing touches OpenGL or the audio device
+	m_renderer = new NullRenderer();
+	m_textRenderer = new NullTextRenderer();
+	AssetArchive::get_instance().open(ASSET_ARCHIVE_FILE);
+	m_textureManager = new TextureManager(true);
+	m_textureManager->loadAtlas(ATLAS_FILE);
+	m_mixer = new NullMixer();
+
+	m_lastTick = SDL_GetTicks();
+	m_lastCounter = SDL_GetPerformanceCounter();
+
+	// Seed random
+	srand(static_cast<unsigned int>(time(0)));
+
 	return true;
 }
 
@@ -89,6 +169,11 @@ bool Engine::running() const {
 }
 
 void Engine::update() {
+	if (m_headless) {
+		updateHeadless();
+		return;
+	}
+
 	#ifdef __APPLE__
 	// 200 is an arbitrary number but it consistently works for me
 	if(mac_fix < 200) {
@@ -102,10 +187,17 @@ void Engine::update() {
 	}
 	#endif
 
-	// Handle the delta time, only tick when the time threshold is reached
-	m_delta = SDL_GetTicks() - m_lastTick;
-	if (m_delta < m_msPerTick) return;
+	Profiler::get_instance().nextFrame();
+	PROFILE_SCOPE("Frame");
+
+	// Measure how long the last frame took and add it to the simulation time
+	Uint64 counter = SDL_GetPerformanceCounter();
+	m_delta = static_cast<double>(counter - m_lastCounter) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+	m_lastCounter = counter;
 	m_lastTick = SDL_GetTicks();
+	m_accumulator += m_delta < MAX_FRAME_TIME ? m_delta : MAX_FRAME_TIME;
+	// Always simulate before the very first render so states are never drawn before updating
+	if (m_simTicks == 0 && m_accumulator < m_msPerTick) m_accumulator = m_msPerTick;
 
 	// Poll for events and update the state accordingly
 	SDL_Event event;
@@ -113,16 +205,120 @@ void Engine::update() {
 		if (event.type == SDL_QUIT) {
 			m_running = false;
 		}
+		// Dump the recorded profile in debug mode
+		if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F11 && getDebugMode()) {
+			writeProfile(PROFILER_TRACE_FILE);
+		}
+		// Toggle the per directory texture memory report in debug mode
+		if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F10 && getDebugMode()) {
+			m_showTextureReport = !m_showTextureReport;
+		}
+		PROFILE_SCOPE("State::handleEvent");
 		if (m_state) m_state->handleEvent(event);
 	}
 
-	getRenderer()->clear();
-	if (m_state) m_state->update(m_delta);
-	if (m_state) m_state->render();
+	// Run as many fixed simulation ticks as the elapsed time allows
+	while (m_accumulator >= m_msPerTick) {
+		PROFILE_SCOPE("State::update");
+		m_simTicks++;
+		if (m_state) m_state->update(static_cast<int>(m_msPerTick));
+		m_accumulator -= m_msPerTick;
+	}
+	m_interpolation = static_cast<float>(m_accumulator / m_msPerTick);
+
+	// Upload textures that finished decoding in the background
+	{
+		PROFILE_SCOPE("TextureManager::update");
+		m_textureManager->update();
+	}
+
+	{
+		PROFILE_SCOPE("State::render");
+		getRenderer()->clear();
+		getRenderer()->beginFrame();
+		if (m_state) m_state->render();
+		getTextRenderer()->flush();
+		getRenderer()->endFrame();
+	}
 	if (getDebugMode()) {
-		getTextRenderer()->render("FPS: " + std::to_string(round(1000.0 / m_delta)), ScreenCoord(0, 0));
+		getTextRenderer()->render("FPS: " + std::to_string(m_delta > 0.0 ? static_cast<int>(round(1000.0 / m_delta)) : 0) +
+			" TICK RATE: " + std::to_string(m_tickRate), ScreenCoord(0, 0));
+		getTextRenderer()->render("SPRITES: " + std::to_string(getRenderer()->getSpriteCount()) +
+			" PRIMITIVES: " + std::to_string(getRenderer()->getPrimitiveCount()), ScreenCoord(0, 32));
+		// GL work of the last frame along with the rolling min/avg/max
+		const RenderStats& stats = RenderStats::get_instance();
+		for (int i = 0; i < static_cast<int>(RenderStat::COUNT); ++i) {
+			RenderStat stat = static_cast<RenderStat>(i);
+			addDebugText(std::string(RenderStats::getName(stat)) + ": " + std::to_string(stats.getLast(stat)) +
+				" MIN: " + std::to_string(stats.getMin(stat)) +
+				" AVG: " + std::to_string(static_cast<int>(round(stats.getAverage(stat)))) +
+				" MAX: " + std::to_string(stats.getMax(stat)));
+		}
+		addDebugText("TEXTURE MEMORY: " + std::to_string(m_textureManager->getResidentBytes() / 1024) +
+			" KB BUDGET: " + std::to_string(m_textureManager->getMemoryBudget() / 1024) + " KB");
+		if (m_showTextureReport) {
+			for (const auto& directory : m_textureManager->getMemoryReport()) {
+				addDebugText("  " + directory.first + ": " + std::to_string(directory.second / 1024) + " KB");
+			}
+		}
+		if (m_textureManager->getPendingCount() > 0) {
+			addDebugText("TEXTURES PENDING: " + std::to_string(m_textureManager->getPendingCount()));
+		}
+		if (m_pacer.getPolicy() == FramePolicy::SLEEP_SPIN) {
+			addDebugText("WAKEUP LATE MS: " + std::to_string(m_pacer.getLastLateness()) +
+				" AVG: " + std::to_string(m_pacer.getAverageLateness()) +
+				" MAX: " + std::to_string(m_pacer.getMaxLateness()));
+		}
+		for (unsigned int i = 0; i < m_debugText.size(); ++i) {
+			getTextRenderer()->render(m_debugText[i], ScreenCoord(0, 64 + 32 * i));
+		}
+		getTextRenderer()->flush();
 	}
-	SDL_GL_SwapWindow(m_window);
+	m_debugText.clear();
+	RenderStats::get_instance().endFrame();
+	{
+		PROFILE_SCOPE("SwapWindow");
+		SDL_GL_SwapWindow(m_window);
+	}
+	if (!m_firstFrameShown) {
+		m_firstFrameShown = true;
+		if (getDebugMode()) {
+			double firstFrame = static_cast<double>(SDL_GetPerformanceCounter() - m_initCounter) * 1000.0 / static_cast<double>(SDL_GetPerformanceFrequency());
+			std::cout << "Time to first frame: " << static_cast<int>(firstFrame) << " ms (init " << static_cast<int>(m_initTime) << " ms)" << std::endl;
+		}
+	}
+
+	// Wait for the next frame according to the frame pacing policy
+	PROFILE_SCOPE("FramePacer::wait");
+	m_pacer.wait();
+}
+
+void Engine::updateHeadless() {
+	Profiler::get_instance().nextFrame();
+	PROFILE_SCOPE("Frame");
+	m_lastTick = SDL_GetTicks();
+
+	SDL_Event event;
+	while (SDL_PollEvent(&event)) {
+		if (event.type == SDL_QUIT) {
+			m_running = false;
+		}
+		if (m_state) m_state->handleEvent(event);
+	}
+
+	// Run exactly one simulation tick per update without waiting
+	PROFILE_SCOPE("State::update");
+	m_simTicks++;
+	if (m_state) m_state->update(static_cast<int>(m_msPerTick));
+}
+
+bool Engine::writeProfile(const std::string& path) {
+	if (Profiler::get_instance().writeTrace(path)) {
+		std::cout << "Wrote profile to " << path << std::endl;
+		return true;
+	}
+	std::cerr << "Failed to write profile to " << path << std::endl;
+	return false;
 }
 
 int Engine::getWindowWidth() const {
@@ -134,11 +330,11 @@ int Engine::getWindowHeight() const
 	return m_windowHeight;
 }
 
-Renderer * Engine::getRenderer() {
+BaseRenderer * Engine::getRenderer() {
 	return m_renderer;
 }
 
-TextRenderer * Engine::getTextRenderer() {
+BaseTextRenderer * Engine::getTextRenderer() {
 	return m_textRenderer;
 }
 
@@ -146,10 +342,24 @@ TextureManager * Engine::getTextureManager() {
 	return m_textureManager;
 }
 
-Mixer * Engine::getMixer() {
+BaseMixer * Engine::getMixer() {
 	return m_mixer;
 }
 
+void Engine::setTickRate(int tickRate) {
+	if (tickRate <= 0) return;
+	m_tickRate = tickRate;
+	m_msPerTick = 1000.0 / static_cast<double>(m_tickRate);
+}
+
+void Engine::setFramePolicy(FramePolicy policy) {
+	m_pacer.setPolicy(policy);
+}
+
+void Engine::setFrameRate(int frameRate) {
+	m_pacer.setFrameRate(frameRate);
+}
+
 void Engine::setState(State * state) {
 	if (m_state) delete m_state;
 	m_state = state;
@@ -157,20 +367,24 @@ void Engine::setState(State * state) {
 
 Engine::Engine() :
 	m_running(true),
+	m_headless(false),
 	m_delta(0),
 	m_lastTick(0),
+	m_lastCounter(0),
+	m_accumulator(0),
+	m_simTicks(0),
+	m_interpolation(0),
 	m_windowWidth(0),
 	m_windowHeight(0),
 	m_tickRate(DEFAULT_TICK_RATE),
-	m_msPerTick(0)
+	m_msPerTick(0),
+	m_initCounter(0),
+	m_initTime(0),
+	m_firstFrameShown(false),
+	m_showTextureReport(false)
 {
-	// Intialize SDL
-	if (SDL_Init(SDL_INIT_EVERYTHING) != 0) {
-		SDL_Log("Unable to initialize SDL: %s", SDL_GetError());
-		// throw new std::exception("SDL failed to initialize");
-	}
 	// Calculate ms per tick depending on tick rate
-	m_msPerTick = static_cast<int>(1000.f / static_cast<float>(m_tickRate));
+	m_msPerTick = 1000.0 / static_cast<double>(m_tickRate);
 }
 
 Engine::~Engine() {
@@ -179,8 +393,9 @@ Engine::~Engine() {
 	delete m_renderer;
 	delete m_textRenderer;
 	delete m_textureManager;
+	m_textureManager = nullptr;
 
-	SDL_GL_DeleteContext(m_context);
-	SDL_DestroyWindow(m_window);
+	if (m_context) SDL_GL_DeleteContext(m_context);
+	if (m_window) SDL_DestroyWindow(m_window);
 	SDL_Quit();
 }
\ No newline at end of file
@@ -2,12 +2,25 @@
 
 #include <SDL2/SDL.h>
 
-#define DEFAULT_TICK_RATE	30	// per second
+#include <string>
+#include <vector>
+
+#include "framePacer.hpp"
 
-class Renderer;
-class TextRenderer;
+#define DEFAULT_TICK_RATE	30	// per second
+// The most time a single frame can add to the simulation, so a long stall doesn't
+// make the simulation try to catch up forever
+#define MAX_FRAME_TIME		250	// ms
+// Where the profile is written when pressing F11 in debug mode
+#define PROFILER_TRACE_FILE	"profile.json"
+// Font used by the text renderer
+#define ENGINE_FONT_FILE	"res/test_font.ttf"
+#define ENGINE_FONT_SIZE	32
+
+class BaseRenderer;
+class BaseTextRenderer;
 class TextureManager;
-class Mixer;
+class BaseMixer;
 
 class State;
 
@@ -26,17 +39,19 @@ public:
 	Engine& operator=(Engine &&) = delete;      // Move assign
 
 	// Functions to make the game function properly
-	bool init(const char * name, int window_width, int window_height);
+	// A headless engine doesn't open a window or audio device, and updates the state as fast as possible without rendering
+	bool init(const char * name, int window_width, int window_height, bool headless = false);
 	bool running() const;
 	void update();
 
 	// Getter functions to make life easier
 	int getWindowWidth() const;
 	int getWindowHeight() const;
-	Renderer * getRenderer();
-	TextRenderer * getTextRenderer();
+	BaseRenderer * getRenderer();
+	BaseTextRenderer * getTextRenderer();
 	TextureManager * getTextureManager();
-	Mixer * getMixer();
+	BaseMixer * getMixer();
+	inline bool isHeadless() const { return m_headless; }
 
 	// State changing functions
 	void setState(State * state);
@@ -45,17 +60,36 @@ public:
 	inline bool getDebugMode() { return m_debugMode; }
 	inline int getTicks() { return m_lastTick; }
 
+	// Simulation timing functions
+	void setTickRate(int tickRate);
+	inline int getTickRate() const { return m_tickRate; }
+	// The number of simulation ticks that have run since the engine started
+	inline unsigned int getSimTicks() const { return m_simTicks; }
+	// How far between the last simulation tick and the next one the current frame is, from 0 to 1
+	inline float getInterpolation() const { return m_interpolation; }
+	// Frame pacing functions to control how the main loop waits between frames
+	void setFramePolicy(FramePolicy policy);
+	void setFrameRate(int frameRate);
+	// Extra lines to show in the debug overlay, cleared every frame
+	inline void addDebugText(const std::string& text) { m_debugText.push_back(text); }
+	// Write the recorded profiler events to a Chrome trace file
+	bool writeProfile(const std::string& path);
+
 
 protected:
 	Engine();
 	~Engine();
+
+	// Headless versions of the init and update functions
+	bool initHeadless();
+	void updateHeadless();
  
 private:
 	// System objects
-	Renderer * m_renderer;
-	TextRenderer * m_textRenderer;
+	BaseRenderer * m_renderer;
+	BaseTextRenderer * m_textRenderer;
 	TextureManager * m_textureManager;
-	Mixer * m_mixer;
+	BaseMixer * m_mixer;
 
 	// SDL/OpenGL specific objects
 	SDL_Window * m_window;
@@ -66,18 +100,35 @@ private:
 
 	// engine variables
 	bool m_running;
-	int m_delta;
+	bool m_headless;
+	double m_delta;
 	int m_lastTick;
+	Uint64 m_lastCounter;
+
+	// Paces rendering so the main loop doesn't busy wait
+	FramePacer m_pacer;
+
+	// Fixed timestep variables, the simulation always advances in steps of m_msPerTick
+	double m_accumulator;
+	unsigned int m_simTicks;
+	float m_interpolation;
 
 	// Other configuration variables
 	int m_windowWidth;
 	int m_windowHeight;
 	int m_tickRate;
-	int m_msPerTick;
+	double m_msPerTick;
+
+	// Startup timing, reported once the first frame is shown
+	Uint64 m_initCounter;
+	double m_initTime;
+	bool m_firstFrameShown;
 
 	// macOS fix
 	int mac_fix;
 
 	// debug mode
 	bool m_debugMode = false;
+	bool m_showTextureReport;
+	std::vector<std::string> m_debugText;
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "framePacer.hpp"
+
+FramePacer::FramePacer() :
+	policy(FramePolicy::SLEEP_SPIN),
+	msPerFrame(1000.0 / DEFAULT_FRAME_RATE),
+	deadline(0),
+	frequency(1),
+	lastLateness(0),
+	lateness(FRAME_PACER_WINDOW, 0.0),
+	latenessIndex(0),
+	latenessCount(0)
+{
+
+}
+
+void FramePacer::setPolicy(FramePolicy policy) {
+	this->policy = policy;
+	// Only the vsync policy should block on buffer swaps
+	SDL_GL_SetSwapInterval(policy == FramePolicy::VSYNC ? 1 : 0);
+	deadline = 0;
+}
+
+void FramePacer::setFrameRate(int frameRate) {
+	if (frameRate <= 0) return;
+	msPerFrame = 1000.0 / static_cast<double>(frameRate);
+	deadline = 0;
+}
+
+void FramePacer::wait() {
+	if (policy != FramePolicy::SLEEP_SPIN) return;
+
+	frequency = SDL_GetPerformanceFrequency();
+	Uint64 now = SDL_GetPerformanceCounter();
+	Uint64 period = fromMs(msPerFrame);
+	// Start a fresh schedule if this is the first frame or we fell more than a frame behind
+	if (deadline == 0 || now > deadline + period) {
+		deadline = now;
+	}
+	deadline += period;
+
+	// Sleep for most of the remaining time, the OS timer isn't precise enough for the last bit
+	double remaining = toMs(deadline - now);
+	if (remaining > FRAME_PACER_SPIN_TIME) {
+		SDL_Delay(static_cast<Uint32>(remaining - FRAME_PACER_SPIN_TIME));
+	}
+	// Then spin until the deadline
+	now = SDL_GetPerformanceCounter();
+	while (now < deadline) {
+		now = SDL_GetPerformanceCounter();
+	}
+
+	// Record how late the wakeup was
+	lastLateness = toMs(now - deadline);
+	lateness[latenessIndex] = lastLateness;
+	latenessIndex = (latenessIndex + 1) % FRAME_PACER_WINDOW;
+	if (latenessCount < FRAME_PACER_WINDOW) latenessCount++;
+}
+
+double FramePacer::getAverageLateness() const {
+	// Slots that haven't been written yet are zero, so only the recorded values are averaged
+	if (latenessCount == 0) return 0.0;
+	double total = 0.0;
+	for (double value : lateness) total += value;
+	return total / static_cast<double>(latenessCount);
+}
+
+double FramePacer::getMaxLateness() const {
+	double result = 0.0;
+	for (double value : lateness) {
+		if (value > result) result = value;
+	}
+	return result;
+}
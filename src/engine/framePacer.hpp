@@ -0,0 +1,63 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <vector>
+
+// Default frame rate the pacer sleeps to when it isn't relying on vsync
+#define DEFAULT_FRAME_RATE		60	// per second
+// How long before the deadline the pacer stops sleeping and spins instead, to make up for coarse OS timers
+#define FRAME_PACER_SPIN_TIME	2.0	// ms
+// Number of frames the wakeup lateness statistics are collected over
+#define FRAME_PACER_WINDOW		120
+
+// The different ways the main loop can wait between frames
+enum class FramePolicy {
+	SLEEP_SPIN,		// Sleep until the next frame deadline, spinning for the last moment to be accurate
+	VSYNC,			// Let the buffer swap block until the display refreshes
+	UNCAPPED		// Don't wait at all, useful for benchmarking
+};
+
+/*	Paces the main loop so it doesn't spin a full core when there's nothing to do
+		- wait() is called once at the end of every frame
+		- Deadlines are spaced evenly from the previous deadline instead of from when the frame finished,
+			so small wakeup errors don't accumulate
+		- Keeps track of how late each wakeup was compared to its deadline
+*/
+class FramePacer {
+
+public:
+	FramePacer();
+
+	void setPolicy(FramePolicy policy);
+	void setFrameRate(int frameRate);
+	inline FramePolicy getPolicy() const { return policy; }
+
+	// Wait until the next frame should start according to the current policy
+	void wait();
+
+	// Wakeup lateness statistics over the last few frames in ms
+	inline double getLastLateness() const { return lastLateness; }
+	double getAverageLateness() const;
+	double getMaxLateness() const;
+
+private:
+
+	FramePolicy policy;
+	double msPerFrame;
+
+	// The time the next frame is supposed to start at, in performance counter units
+	Uint64 deadline;
+	Uint64 frequency;
+
+	// Recent wakeup lateness values
+	double lastLateness;
+	std::vector<double> lateness;
+	unsigned int latenessIndex;
+	// Number of values recorded so far, up to the size of the window
+	unsigned int latenessCount;
+
+	inline double toMs(Uint64 counter) const { return static_cast<double>(counter) * 1000.0 / static_cast<double>(frequency); }
+	inline Uint64 fromMs(double ms) const { return static_cast<Uint64>(ms * static_cast<double>(frequency) / 1000.0); }
+
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "renderer.hpp"
+#include "text/textRenderer.hpp"
+#include "mixer.hpp"
+
+/*	Null backends used when the engine runs headless
+		- Nothing is drawn or played, every call is a no op
+		- Lets states update without a window, GPU or audio device
+*/
+
+class NullRenderer : public BaseRenderer {
+
+public:
+	void clear() const override {}
+	void drawLine_fast(ScreenCoord v1, ScreenCoord v2, Colour colour, float alpha = 1.f) override {}
+	void drawLine(ScreenCoord v1, ScreenCoord v2, Colour colour, float alpha = 1.f) override {}
+	void drawRect_fast(ScreenCoord v, int width, int height, Colour colour, float alpha = 1.f) override {}
+	void drawRect(ScreenCoord v, int width, int height, Colour colour, float alpha = 1.f) override {}
+	void drawTexture(ScreenCoord v, int width, int height, const Texture& texture) override {}
+	void drawSprite_fast(const Sprite& sprite) override {}
+	void drawSprite(const Sprite& sprite) override {}
+	void drawSpriteMesh(const SpriteMesh& mesh, const Texture& texture) override {}
+	void drawParticles(const Texture& texture, const ParticleInstance * instances, unsigned int count) override {}
+
+	void beginFrame() override {}
+	void endFrame() override {}
+	void flush() override {}
+
+	unsigned int getSpriteCount() const override { return 0; }
+	unsigned int getPrimitiveCount() const override { return 0; }
+};
+
+class NullTextRenderer : public BaseTextRenderer {
+
+public:
+	void render(const std::string& s, ScreenCoord pos, float scale = 1.f) override {}
+	void flush() override {}
+};
+
+class NullMixer : public BaseMixer {
+
+public:
+	void loadAudio(const std::string &filePath, AudioType audioType) override {}
+	void playAudio(const std::string &filePath, int loops, float volume = 1) override {}
+
+	void pauseAllAudio() override {}
+	void resumeAllAudio() override {}
+
+	void fadeOutAllMusic(int ms) override {}
+	void fadeInMusic(const std::string &filePath, int ms, int loops = 0) override {}
+};
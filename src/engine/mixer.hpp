@@ -12,19 +12,34 @@
  */
 enum class AudioType { Chunk, Music };
 
-class Mixer {
+// Interface of the audio backend, so the engine can run without an audio device
+class BaseMixer {
+public:
+    virtual ~BaseMixer() {}
+
+    virtual void loadAudio(const std::string &filePath, AudioType audioType) = 0;
+    virtual void playAudio(const std::string &filePath, int loops, float volume = 1) = 0;
+
+    virtual void pauseAllAudio() = 0;
+    virtual void resumeAllAudio() = 0;
+
+    virtual void fadeOutAllMusic(int ms) = 0;
+    virtual void fadeInMusic(const std::string &filePath, int ms, int loops = 0) = 0;
+};
+
+class Mixer : public BaseMixer {
 public:
     Mixer();
     ~Mixer();
 
-    void loadAudio(const std::string &filePath, AudioType audioType);
-    void playAudio(const std::string &filePath, int loops, float volume = 1);
+    void loadAudio(const std::string &filePath, AudioType audioType) override;
+    void playAudio(const std::string &filePath, int loops, float volume = 1) override;
 
-    void pauseAllAudio();
-    void resumeAllAudio();
+    void pauseAllAudio() override;
+    void resumeAllAudio() override;
 
-    void fadeOutAllMusic(int ms);
-    void fadeInMusic(const std::string &filePath, int ms, int loops = 0);
+    void fadeOutAllMusic(int ms) override;
+    void fadeInMusic(const std::string &filePath, int ms, int loops = 0) override;
 private:
     std::unordered_map<std::string, Mix_Music*> m_music;
     std::unordered_map<std::string, Mix_Chunk*> m_chunks;
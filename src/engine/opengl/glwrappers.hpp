@@ -5,9 +5,13 @@
 #include "vertexBuffer.hpp"
 #include "indexBuffer.hpp"
 #include "vertexBufferLayout.hpp"
+#include "streamBuffer.hpp"
 
 // Shader wrapper
 #include "shader.hpp"
 
 // Texture wrapper
-#include "texture.hpp"
\ No newline at end of file
+#include "texture.hpp"
+
+// Per frame counters of the GL work
+#include "renderStats.hpp"
\ No newline at end of file
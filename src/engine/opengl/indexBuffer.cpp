@@ -1,9 +1,11 @@
 #include "indexBuffer.hpp"
+#include "renderStats.hpp"
 
 #include <iostream>
 
 IndexBuffer::IndexBuffer(const unsigned int * data, unsigned int count) : count(count) {
 	glGenBuffers(1, &bufferID);
+	RenderStats::get_instance().add(RenderStat::BUFFER_CREATIONS);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferID);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW);
 }
@@ -0,0 +1,63 @@
+#include "renderStats.hpp"
+
+RenderStats::RenderStats() :
+	historyIndex(0),
+	historySize(0)
+{
+	for (int i = 0; i < static_cast<int>(RenderStat::COUNT); ++i) {
+		current[i] = 0;
+	}
+}
+
+void RenderStats::endFrame() {
+	for (int i = 0; i < static_cast<int>(RenderStat::COUNT); ++i) {
+		history[historyIndex][i] = current[i];
+		current[i] = 0;
+	}
+	historyIndex = (historyIndex + 1) % RENDER_STATS_WINDOW;
+	if (historySize < RENDER_STATS_WINDOW) historySize++;
+}
+
+unsigned int RenderStats::getLast(RenderStat stat) const {
+	if (historySize == 0) return 0;
+	unsigned int last = (historyIndex + RENDER_STATS_WINDOW - 1) % RENDER_STATS_WINDOW;
+	return history[last][static_cast<int>(stat)];
+}
+
+unsigned int RenderStats::getMin(RenderStat stat) const {
+	if (historySize == 0) return 0;
+	unsigned int min = history[0][static_cast<int>(stat)];
+	for (unsigned int i = 1; i < historySize; ++i) {
+		if (history[i][static_cast<int>(stat)] < min) min = history[i][static_cast<int>(stat)];
+	}
+	return min;
+}
+
+unsigned int RenderStats::getMax(RenderStat stat) const {
+	unsigned int max = 0;
+	for (unsigned int i = 0; i < historySize; ++i) {
+		if (history[i][static_cast<int>(stat)] > max) max = history[i][static_cast<int>(stat)];
+	}
+	return max;
+}
+
+float RenderStats::getAverage(RenderStat stat) const {
+	if (historySize == 0) return 0.f;
+	unsigned int total = 0;
+	for (unsigned int i = 0; i < historySize; ++i) {
+		total += history[i][static_cast<int>(stat)];
+	}
+	return static_cast<float>(total) / static_cast<float>(historySize);
+}
+
+const char * RenderStats::getName(RenderStat stat) {
+	switch (stat) {
+	case RenderStat::DRAW_CALLS:		return "DRAW CALLS";
+	case RenderStat::VERTICES:			return "VERTICES";
+	case RenderStat::TEXTURE_BINDS:		return "TEXTURE BINDS";
+	case RenderStat::SHADER_BINDS:		return "SHADER BINDS";
+	case RenderStat::UNIFORM_UPLOADS:	return "UNIFORMS";
+	case RenderStat::BUFFER_CREATIONS:	return "BUFFERS CREATED";
+	default:							return "";
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+// Number of frames the rolling min/avg/max are computed over
+#define RENDER_STATS_WINDOW	120
+
+// Everything the OpenGL wrappers keep count of
+enum class RenderStat {
+	DRAW_CALLS,
+	VERTICES,
+	TEXTURE_BINDS,
+	SHADER_BINDS,
+	UNIFORM_UPLOADS,
+	BUFFER_CREATIONS,
+	COUNT
+};
+
+/*	Per frame counters of the work submitted to OpenGL
+		- The renderers and GL wrappers call add() whenever they issue the matching GL call
+		- endFrame() moves the current counts into a rolling window of the last frames,
+			which the debug overlay reads the last/min/avg/max values from
+*/
+class RenderStats {
+
+public:
+	// Accessor method for singleton pattern
+	static RenderStats& get_instance() {
+		static RenderStats stats;
+		return stats;
+	}
+
+	// Delete copy and move constructors and assign operators
+	RenderStats(RenderStats const&) = delete;             // Copy construct
+	RenderStats(RenderStats&&) = delete;                  // Move construct
+	RenderStats& operator=(RenderStats const&) = delete;  // Copy assign
+	RenderStats& operator=(RenderStats &&) = delete;      // Move assign
+
+	inline void add(RenderStat stat, unsigned int amount = 1) { current[static_cast<int>(stat)] += amount; }
+	void endFrame();
+
+	// Values of the last complete frame and over the rolling window
+	unsigned int getLast(RenderStat stat) const;
+	unsigned int getMin(RenderStat stat) const;
+	unsigned int getMax(RenderStat stat) const;
+	float getAverage(RenderStat stat) const;
+
+	static const char * getName(RenderStat stat);
+
+protected:
+	RenderStats();
+	~RenderStats() {}
+
+private:
+	unsigned int current[static_cast<int>(RenderStat::COUNT)];
+	unsigned int history[RENDER_STATS_WINDOW][static_cast<int>(RenderStat::COUNT)];
+	unsigned int historyIndex;
+	unsigned int historySize;
+
+};
@@ -1,4 +1,5 @@
 #include "shader.hpp"
+#include "renderStats.hpp"
 
 #include <string>
 #include <iostream>
@@ -19,6 +20,7 @@ Shader::~Shader() {
 
 void Shader::bind() const {
 	glUseProgram(rendererID);
+	RenderStats::get_instance().add(RenderStat::SHADER_BINDS);
 }
 
 void Shader::unbind() const {
@@ -28,26 +30,31 @@ void Shader::unbind() const {
 void Shader::setUniform1i(const std::string & name, int value) {
 	bind();
 	glUniform1i(getUniformLocation(name), value);
+	RenderStats::get_instance().add(RenderStat::UNIFORM_UPLOADS);
 }
 
 void Shader::setUniform2i(const std::string & name, int v0, int v1) {
 	bind();
 	glUniform2i(getUniformLocation(name), v0, v1);
+	RenderStats::get_instance().add(RenderStat::UNIFORM_UPLOADS);
 }
 
 void Shader::setUniform3f(const std::string& name, float v0, float v1, float v2) {
 	bind();
 	glUniform3f(getUniformLocation(name), v0, v1, v2);
+	RenderStats::get_instance().add(RenderStat::UNIFORM_UPLOADS);
 }
 
 void Shader::setUniform4f(const std::string & name, float v0, float v1, float v2, float v3) {
 	bind();
 	glUniform4f(getUniformLocation(name), v0, v1, v2, v3);
+	RenderStats::get_instance().add(RenderStat::UNIFORM_UPLOADS);
 }
 
 void Shader::setUniformmat4(const std::string & name, float* m) {
 	bind();
 	glUniformMatrix4fv(getUniformLocation(name), 1, true, static_cast<GLfloat*>(m));
+	RenderStats::get_instance().add(RenderStat::UNIFORM_UPLOADS);
 }
 
 GLint Shader::getUniformLocation(const std::string & name) {
@@ -0,0 +1,52 @@
+#include "streamBuffer.hpp"
+#include "renderStats.hpp"
+
+#include <cstring>
+
+StreamBuffer::StreamBuffer(unsigned int size) : capacity(size), head(0) {
+	glGenBuffers(1, &bufferID);
+	RenderStats::get_instance().add(RenderStat::BUFFER_CREATIONS);
+	glBindBuffer(GL_ARRAY_BUFFER, bufferID);
+	glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+StreamBuffer::~StreamBuffer() {
+	glDeleteBuffers(1, &bufferID);
+}
+
+GLintptr StreamBuffer::write(const void * data, unsigned int size) {
+	bind();
+	unsigned int offset = (head + STREAM_BUFFER_ALIGNMENT - 1) / STREAM_BUFFER_ALIGNMENT * STREAM_BUFFER_ALIGNMENT;
+	// Start over in fresh storage once the ring is full
+	if (offset + size > capacity) {
+		orphan();
+		offset = 0;
+	}
+
+	// Nothing in flight reads from this range, so there is no need to synchronize with the GPU
+	void * dst = glMapBufferRange(GL_ARRAY_BUFFER, offset, size,
+		GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (dst) {
+		memcpy(dst, data, size);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+	}
+	else {
+		glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+	}
+	head = offset + size;
+	return static_cast<GLintptr>(offset);
+}
+
+void StreamBuffer::bind() const {
+	glBindBuffer(GL_ARRAY_BUFFER, bufferID);
+}
+
+void StreamBuffer::unbind() const {
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void StreamBuffer::orphan() {
+	glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+	head = 0;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <GL/glew.h>
+
+// Size of the streaming vertex storage in bytes
+#define STREAM_BUFFER_SIZE		(256 * 1024)
+// Every write starts on a multiple of this, so any vertex layout up to this stride can index into it
+#define STREAM_BUFFER_ALIGNMENT	16
+
+/*	A vertex buffer for data that changes on every draw
+		- Data is appended to the buffer like a ring, so a draw never overwrites a range
+			that an earlier draw in flight may still be reading from
+		- Writes map the range unsynchronized, so the CPU never waits on the GPU
+		- When the end is reached the whole storage is orphaned, the driver hands out fresh
+			memory and keeps the old one alive until the GPU is done with it
+*/
+class StreamBuffer {
+
+public:
+	StreamBuffer(unsigned int size = STREAM_BUFFER_SIZE);
+	~StreamBuffer();
+
+	// Copy data into the buffer and return its byte offset
+	GLintptr write(const void * data, unsigned int size);
+
+	void bind() const;
+	void unbind() const;
+
+	inline GLuint getBufferID() const { return bufferID; }
+
+private:
+	GLuint bufferID;
+	unsigned int capacity;
+	// Byte offset of the next write
+	unsigned int head;
+
+	void orphan();
+};
@@ -1,15 +1,18 @@
 #include "texture.hpp"
+#include "renderStats.hpp"
 
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image/stb_image.h>
+Texture::Texture(int width, int height)
+	: textureID(0), width(width), height(height), bitsPerPixel(4)
+{
+}
 
-Texture::Texture(const std::string & path)
-	: textureID(0), filePath(path), localBuffer(nullptr),
-	width(0), height(0), bitsPerPixel(0)
+Texture::Texture(int width, int height, const unsigned char * pixels)
+	: textureID(0), width(width), height(height), bitsPerPixel(4)
 {
-	stbi_set_flip_vertically_on_load(1);
-	localBuffer = stbi_load(path.c_str(), &width, &height, &bitsPerPixel, 4);
+	createTexture(pixels);
+}
 
+void Texture::createTexture(const unsigned char * pixels) {
 	glGenTextures(1, &textureID);
 	glBindTexture(GL_TEXTURE_2D, textureID);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -17,21 +20,18 @@ Texture::Texture(const std::string & path)
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, localBuffer);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 	glBindTexture(GL_TEXTURE_2D, 0);
-
-	if (localBuffer) {
-		stbi_image_free(localBuffer);
-	}
 }
 
 Texture::~Texture() {
-	glDeleteTextures(1, &textureID);
+	if (textureID) glDeleteTextures(1, &textureID);
 }
 
 void Texture::bind(unsigned int slot /*= 0*/) const {
 	glActiveTexture(GL_TEXTURE0 + slot);
 	glBindTexture(GL_TEXTURE_2D, textureID);
+	RenderStats::get_instance().add(RenderStat::TEXTURE_BINDS);
 }
 
 void Texture::unbind() const {
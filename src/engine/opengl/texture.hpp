@@ -2,12 +2,13 @@
 
 #include <GL/glew.h>
 
-#include <string>
-
 class Texture {
 
 public:
-	Texture(const std::string& path);
+	// Headless texture that only knows its size, no OpenGL texture is created
+	Texture(int width, int height);
+	// Create a texture from already decoded RGBA pixels
+	Texture(int width, int height, const unsigned char * pixels);
 	~Texture();
 
 	void bind(unsigned int slot = 0) const;
@@ -16,8 +17,8 @@ public:
 	inline int getWidth() const { return width; }
 	inline int getHeight() const { return height; }
 private:
+	void createTexture(const unsigned char * pixels);
+
 	GLuint textureID;
-	std::string filePath;
-	unsigned char * localBuffer;
 	int width, height, bitsPerPixel;
 };
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include "vertexArray.hpp"
+#include "renderStats.hpp"
 
 VertexArray::VertexArray() {
 	glGenVertexArrays(1, &arrayID);
+	RenderStats::get_instance().add(RenderStat::BUFFER_CREATIONS);
 }
 
 VertexArray::~VertexArray() {
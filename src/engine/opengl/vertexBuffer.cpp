@@ -1,7 +1,9 @@
 #include "vertexBuffer.hpp"
+#include "renderStats.hpp"
 
 VertexBuffer::VertexBuffer(const void* data, unsigned int size) {
 	glGenBuffers(1, &bufferID);
+	RenderStats::get_instance().add(RenderStat::BUFFER_CREATIONS);
 	glBindBuffer(GL_ARRAY_BUFFER, bufferID);
 	glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
 }
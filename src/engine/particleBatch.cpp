@@ -0,0 +1,69 @@
+#include "particleBatch.hpp"
+
+#include <algorithm>
+
+// Unit quad that gets stretched over the origin and size of every particle
+const GLfloat PARTICLE_QUAD_VERTICES[12] = {
+	0.0f, 1.0f,
+	1.0f, 0.0f,
+	0.0f, 0.0f,
+
+	0.0f, 1.0f,
+	1.0f, 1.0f,
+	1.0f, 0.0f
+};
+
+ParticleBatch::ParticleBatch() :
+	shader("res/shaders/particle_vertex.glsl", "res/shaders/basic_texture.glsl")
+{
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &quadVBO);
+	glGenBuffers(1, &instanceVBO);
+	RenderStats::get_instance().add(RenderStat::BUFFER_CREATIONS, 3);
+
+	glBindVertexArray(VAO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(PARTICLE_QUAD_VERTICES), PARTICLE_QUAD_VERTICES, GL_STATIC_DRAW);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (void*)0);
+
+	// The instance attributes advance once per particle instead of once per vertex
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(ParticleInstance) * PARTICLE_BATCH_MAX_PARTICLES, nullptr, GL_STREAM_DRAW);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (void*)0);
+	glVertexAttribDivisor(1, 1);
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance), (void*)(4 * sizeof(GLfloat)));
+	glVertexAttribDivisor(2, 1);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+ParticleBatch::~ParticleBatch() {
+	glDeleteBuffers(1, &quadVBO);
+	glDeleteBuffers(1, &instanceVBO);
+	glDeleteVertexArrays(1, &VAO);
+}
+
+void ParticleBatch::draw(const Texture & texture, const ParticleInstance * instances, unsigned int count) {
+	if (count == 0) return;
+
+	shader.bind();
+	texture.bind();
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	for (unsigned int first = 0; first < count; first += PARTICLE_BATCH_MAX_PARTICLES) {
+		unsigned int size = std::min(count - first, static_cast<unsigned int>(PARTICLE_BATCH_MAX_PARTICLES));
+		// Orphan the old buffer storage so the driver doesn't stall on the previous draw
+		glBufferData(GL_ARRAY_BUFFER, sizeof(ParticleInstance) * PARTICLE_BATCH_MAX_PARTICLES, nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(ParticleInstance) * size, instances + first);
+		glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(size));
+		RenderStats::get_instance().add(RenderStat::DRAW_CALLS);
+		RenderStats::get_instance().add(RenderStat::VERTICES, 6 * size);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include "opengl/glwrappers.hpp"
+
+// The maximum number of particles uploaded per draw call, bigger systems are drawn in several calls
+#define PARTICLE_BATCH_MAX_PARTICLES	8192
+
+// Per instance data of a particle quad
+struct ParticleInstance {
+	// Origin and size in screen space, the unit quad is stretched over it
+	GLfloat x, y;
+	GLfloat w, h;
+	// Texture coordinates of the origin and the opposite corner
+	GLfloat u0, v0;
+	GLfloat u1, v1;
+};
+
+/*	Draws whole particle systems as instanced textured quads
+		- The particle system writes one instance per particle straight from its particle pool,
+			so particles are drawn without going through sprites
+		- Every particle of a system shares one texture, so a system is a single draw call
+			unless it has more particles than fit in the instance buffer
+*/
+class ParticleBatch {
+
+public:
+	ParticleBatch();
+	~ParticleBatch();
+
+	void draw(const Texture& texture, const ParticleInstance * instances, unsigned int count);
+
+private:
+	Shader shader;
+
+	// Unit quad and the instance buffer it reads the particles from
+	GLuint VAO, quadVBO, instanceVBO;
+};
@@ -0,0 +1,162 @@
+#include "particleKernels.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PARTICLE_KERNELS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and clang only emit vector instructions in functions that ask for them, MSVC always does
+#if defined(PARTICLE_KERNELS_X86) && !defined(_MSC_VER)
+#define PARTICLE_TARGET_SSE2 __attribute__((target("sse2")))
+#define PARTICLE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PARTICLE_TARGET_SSE2
+#define PARTICLE_TARGET_AVX2
+#endif
+
+namespace {
+
+	// Integrate the particles [begin, end) one at a time
+	bool integrateScalar(const ParticleStreams& s, size_t begin, size_t end) {
+		bool dead = false;
+		for (size_t i = begin; i < end; ++i) {
+			s.previousX[i] = s.x[i];
+			s.previousY[i] = s.y[i];
+			// maxY is a whole number, so comparing against it is the same as comparing the pixel position
+			bool falls = s.gravity[i] != 0.f;
+			bool moving = !falls || s.y[i] < s.maxY[i];
+			if (moving) {
+				s.x[i] += s.velocityX[i];
+				s.y[i] += s.velocityY[i];
+				s.velocityY[i] += s.gravity[i];
+			}
+			if (!moving || !falls) s.age[i]++;
+			if (s.age[i] > s.lifespan[i]) dead = true;
+		}
+		return dead;
+	}
+
+#ifdef PARTICLE_KERNELS_X86
+	PARTICLE_TARGET_SSE2
+	bool integrateSSE2(const ParticleStreams& s, size_t count) {
+		const __m128 zero = _mm_setzero_ps();
+		__m128i dead = _mm_setzero_si128();
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4) {
+			__m128 x = _mm_loadu_ps(s.x + i);
+			__m128 y = _mm_loadu_ps(s.y + i);
+			__m128 gravity = _mm_loadu_ps(s.gravity + i);
+			_mm_storeu_ps(s.previousX + i, x);
+			_mm_storeu_ps(s.previousY + i, y);
+
+			// All bits set in the lanes where the condition holds
+			__m128 still = _mm_cmpeq_ps(gravity, zero);
+			__m128 above = _mm_cmplt_ps(y, _mm_loadu_ps(s.maxY + i));
+			__m128 moving = _mm_or_ps(still, above);
+			__m128 aging = _mm_or_ps(still, _mm_cmpnlt_ps(y, _mm_loadu_ps(s.maxY + i)));
+
+			_mm_storeu_ps(s.x + i, _mm_add_ps(x, _mm_and_ps(_mm_loadu_ps(s.velocityX + i), moving)));
+			__m128 velocityY = _mm_loadu_ps(s.velocityY + i);
+			_mm_storeu_ps(s.y + i, _mm_add_ps(y, _mm_and_ps(velocityY, moving)));
+			_mm_storeu_ps(s.velocityY + i, _mm_add_ps(velocityY, _mm_and_ps(gravity, moving)));
+
+			// A set mask is -1, so subtracting it adds one to the age
+			__m128i age = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s.age + i)), _mm_castps_si128(aging));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(s.age + i), age);
+			dead = _mm_or_si128(dead, _mm_cmpgt_epi32(age, _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.lifespan + i))));
+		}
+		bool tailDead = integrateScalar(s, i, count);
+		return _mm_movemask_epi8(dead) != 0 || tailDead;
+	}
+
+	PARTICLE_TARGET_AVX2
+	bool integrateAVX2(const ParticleStreams& s, size_t count) {
+		const __m256 zero = _mm256_setzero_ps();
+		__m256i dead = _mm256_setzero_si256();
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8) {
+			__m256 x = _mm256_loadu_ps(s.x + i);
+			__m256 y = _mm256_loadu_ps(s.y + i);
+			__m256 gravity = _mm256_loadu_ps(s.gravity + i);
+			_mm256_storeu_ps(s.previousX + i, x);
+			_mm256_storeu_ps(s.previousY + i, y);
+
+			__m256 maxY = _mm256_loadu_ps(s.maxY + i);
+			__m256 still = _mm256_cmp_ps(gravity, zero, _CMP_EQ_OQ);
+			__m256 moving = _mm256_or_ps(still, _mm256_cmp_ps(y, maxY, _CMP_LT_OQ));
+			__m256 aging = _mm256_or_ps(still, _mm256_cmp_ps(y, maxY, _CMP_NLT_UQ));
+
+			_mm256_storeu_ps(s.x + i, _mm256_add_ps(x, _mm256_and_ps(_mm256_loadu_ps(s.velocityX + i), moving)));
+			__m256 velocityY = _mm256_loadu_ps(s.velocityY + i);
+			_mm256_storeu_ps(s.y + i, _mm256_add_ps(y, _mm256_and_ps(velocityY, moving)));
+			_mm256_storeu_ps(s.velocityY + i, _mm256_add_ps(velocityY, _mm256_and_ps(gravity, moving)));
+
+			__m256i age = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.age + i)), _mm256_castps_si256(aging));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(s.age + i), age);
+			dead = _mm256_or_si256(dead, _mm256_cmpgt_epi32(age, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.lifespan + i))));
+		}
+		bool tailDead = integrateScalar(s, i, count);
+		return _mm256_movemask_epi8(dead) != 0 || tailDead;
+	}
+
+	bool cpuSupports(ParticleKernel kernel) {
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		int maxLeaf = info[0];
+		__cpuid(info, 1);
+		if (kernel == ParticleKernel::SSE2) return (info[3] & (1 << 26)) != 0;
+		// AVX2 also needs the OS to save the YMM registers
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		if (!osxsave || maxLeaf < 7 || (_xgetbv(0) & 0x6) != 0x6) return false;
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		if (kernel == ParticleKernel::SSE2) return __builtin_cpu_supports("sse2");
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+#endif
+
+}
+
+namespace ParticleKernels {
+
+	bool isSupported(ParticleKernel kernel) {
+		if (kernel == ParticleKernel::SCALAR) return true;
+#ifdef PARTICLE_KERNELS_X86
+		static const bool sse2 = cpuSupports(ParticleKernel::SSE2);
+		static const bool avx2 = cpuSupports(ParticleKernel::AVX2);
+		return kernel == ParticleKernel::SSE2 ? sse2 : avx2;
+#else
+		return false;
+#endif
+	}
+
+	ParticleKernel getBest() {
+		if (isSupported(ParticleKernel::AVX2)) return ParticleKernel::AVX2;
+		if (isSupported(ParticleKernel::SSE2)) return ParticleKernel::SSE2;
+		return ParticleKernel::SCALAR;
+	}
+
+	const char * getName(ParticleKernel kernel) {
+		switch (kernel) {
+		case ParticleKernel::SSE2:	return "SSE2";
+		case ParticleKernel::AVX2:	return "AVX2";
+		default:					return "SCALAR";
+		}
+	}
+
+	bool integrate(ParticleKernel kernel, const ParticleStreams& streams, size_t count) {
+#ifdef PARTICLE_KERNELS_X86
+		if (kernel == ParticleKernel::AVX2) return integrateAVX2(streams, count);
+		if (kernel == ParticleKernel::SSE2) return integrateSSE2(streams, count);
+#endif
+		return integrateScalar(streams, 0, count);
+	}
+
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+
+// Pointers to the particle arrays a kernel works on, every array holds the same number of particles
+struct ParticleStreams {
+	float * x;
+	float * y;
+	float * previousX;
+	float * previousY;
+	float * velocityX;
+	float * velocityY;
+	const float * gravity;
+	const float * maxY;
+	int * age;
+	const int * lifespan;
+};
+
+// Instruction sets the integration kernel is written for
+enum class ParticleKernel {
+	SCALAR,
+	SSE2,
+	AVX2
+};
+
+/*	Integrates a tick of particle movement
+		- Saves the previous position, moves the particles, applies gravity until a particle
+			reaches its maxY, ages the particles and tests them against their lifespan
+		- Particles without gravity have a gravity of zero, they always move and age every tick
+		- The SSE2 and AVX2 versions process 4 and 8 particles at once, the fastest one the CPU
+			supports is picked at runtime and the rest falls back to the scalar version
+*/
+namespace ParticleKernels {
+
+	// The fastest kernel the CPU supports
+	ParticleKernel getBest();
+	bool isSupported(ParticleKernel kernel);
+	const char * getName(ParticleKernel kernel);
+
+	// Integrate count particles, returns true if any of them outlived its lifespan
+	bool integrate(ParticleKernel kernel, const ParticleStreams& streams, size_t count);
+
+}
@@ -0,0 +1,107 @@
+#include "particlePool.hpp"
+
+#include <algorithm>
+
+#include "particleWorkers.hpp"
+
+void ParticlePool::add(float x, float y, float velocityX, float velocityY, float gravity, float maxY, int lifespan, unsigned int emitter)
+{
+	this->x.push_back(x);
+	this->y.push_back(y);
+	previousX.push_back(x);
+	previousY.push_back(y);
+	this->velocityX.push_back(velocityX);
+	this->velocityY.push_back(velocityY);
+	this->gravity.push_back(gravity);
+	this->maxY.push_back(maxY);
+	age.push_back(0);
+	this->lifespan.push_back(lifespan);
+	this->emitter.push_back(emitter);
+}
+
+void ParticlePool::resize(size_t count)
+{
+	x.resize(count);
+	y.resize(count);
+	previousX.resize(count);
+	previousY.resize(count);
+	velocityX.resize(count);
+	velocityY.resize(count);
+	gravity.resize(count);
+	maxY.resize(count);
+	age.resize(count);
+	lifespan.resize(count);
+	emitter.resize(count);
+}
+
+void ParticlePool::update(std::vector<unsigned int>& deaths)
+{
+	// Move every particle at once with the fastest kernel the CPU supports
+	static const ParticleKernel kernel = ParticleKernels::getBest();
+	size_t count = size();
+	if (count == 0) return;
+
+	ParticleWorkers& workers = ParticleWorkers::get_instance();
+	unsigned int chunks = workers.getChunkCount(count);
+	// Chunks start on a multiple of the widest kernel so only the last one has a scalar tail
+	size_t chunkSize = ((count + chunks - 1) / chunks + 7) & ~static_cast<size_t>(7);
+	chunkEnds.resize(chunks);
+	chunkDeaths.resize(chunks);
+
+	workers.run(chunks, [&](unsigned int chunk) {
+		size_t begin = std::min(chunk * chunkSize, count);
+		size_t end = std::min(begin + chunkSize, count);
+		chunkDeaths[chunk].clear();
+		bool dead = begin < end && ParticleKernels::integrate(kernel, getStreams(begin), end - begin);
+		chunkEnds[chunk] = dead ? compact(begin, end, chunkDeaths[chunk]) : end;
+	});
+
+	// Close the gaps the chunks left, in chunk order so the result doesn't depend on the chunk count
+	size_t survivors = chunkEnds[0];
+	deaths.insert(deaths.end(), chunkDeaths[0].begin(), chunkDeaths[0].end());
+	for (unsigned int chunk = 1; chunk < chunks; ++chunk) {
+		size_t begin = std::min(chunk * chunkSize, count);
+		for (size_t i = begin; i < chunkEnds[chunk]; ++i) {
+			move(i, survivors++);
+		}
+		deaths.insert(deaths.end(), chunkDeaths[chunk].begin(), chunkDeaths[chunk].end());
+	}
+	if (survivors != count) resize(survivors);
+}
+
+ParticleStreams ParticlePool::getStreams(size_t begin)
+{
+	return { x.data() + begin, y.data() + begin, previousX.data() + begin, previousY.data() + begin,
+		velocityX.data() + begin, velocityY.data() + begin, gravity.data() + begin, maxY.data() + begin,
+		age.data() + begin, lifespan.data() + begin };
+}
+
+size_t ParticlePool::compact(size_t begin, size_t end, std::vector<unsigned int>& deaths)
+{
+	size_t survivors = begin;
+	for (size_t i = begin; i < end; ++i) {
+		if (age[i] > lifespan[i]) {
+			deaths.push_back(emitter[i]);
+		}
+		else {
+			move(i, survivors++);
+		}
+	}
+	return survivors;
+}
+
+void ParticlePool::move(size_t from, size_t to)
+{
+	if (from == to) return;
+	x[to] = x[from];
+	y[to] = y[from];
+	previousX[to] = previousX[from];
+	previousY[to] = previousY[from];
+	velocityX[to] = velocityX[from];
+	velocityY[to] = velocityY[from];
+	gravity[to] = gravity[from];
+	maxY[to] = maxY[from];
+	age[to] = age[from];
+	lifespan[to] = lifespan[from];
+	emitter[to] = emitter[from];
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "particleKernels.hpp"
+
+/*	The particles of every emitter in a particle system, stored as a structure of arrays
+		- Particles are plain values in contiguous arrays, so spawning doesn't allocate once the
+			arrays have grown and an update walks every array in order
+		- Big pools are updated in chunks on the particle workers, every chunk removes its dead
+			particles in place and the survivors are then moved together in chunk order
+		- Removal keeps the survivors in order, so the pool ends up the same however many
+			chunks it was split into
+*/
+struct ParticlePool {
+	std::vector<float> x, y;
+	// Position before the last update, used to interpolate rendering between simulation ticks
+	std::vector<float> previousX, previousY;
+	// Velocity already scaled by the speed of the particle
+	std::vector<float> velocityX, velocityY;
+	// Added to the vertical velocity every tick, zero for particles without gravity
+	std::vector<float> gravity;
+	// Gravity particles fall until they reach this height and only start aging after that
+	std::vector<float> maxY;
+	std::vector<int> age;
+	std::vector<int> lifespan;
+	// Index of the emitter that spawned the particle
+	std::vector<unsigned int> emitter;
+
+	inline size_t size() const { return x.size(); }
+	void add(float x, float y, float velocityX, float velocityY, float gravity, float maxY, int lifespan, unsigned int emitter);
+	void resize(size_t count);
+
+	// Integrate every particle a tick and remove the ones that outlived their lifespan
+	// The emitter of every removed particle is appended to deaths
+	void update(std::vector<unsigned int>& deaths);
+
+private:
+	ParticleStreams getStreams(size_t begin);
+	// Move the survivors of [begin, end) to the start of the range, returns the end of the survivors
+	size_t compact(size_t begin, size_t end, std::vector<unsigned int>& deaths);
+	void move(size_t from, size_t to);
+
+	// Results of every chunk of the last update, kept to avoid allocating every tick
+	std::vector<size_t> chunkEnds;
+	std::vector<std::vector<unsigned int>> chunkDeaths;
+};
@@ -1,211 +1,176 @@
 #include "particleSystem.hpp"
 
+#include "profiler.hpp"
+
 ParticleSystem::ParticleSystem() :
-	sprite("res/assets/tiles/particles.png")
+	sheet("res/assets/tiles/particles.png"),
+	updateTick(0)
 {
-	sprite.setSize(30, 30);
+
 }
 
 void ParticleSystem::render()
 {
-	for (Emitter * e : emitters) {
-		e->render(sprite);
+	if (particles.size() == 0) return;
+
+	// Every particle of an emitter shares its size and texture coordinates, so work them out once per emitter
+	emitterInstances.resize(emitters.size());
+	for (size_t i = 0; i < emitters.size(); ++i) {
+		const Emitter& emitter = emitters[i];
+		ParticleInstance& instance = emitterInstances[i];
+		instance.w = PARTICLE_SIZE;
+		instance.h = -PARTICLE_SIZE;
+		instance.u0 = static_cast<GLfloat>(sheet.atlas_x + emitter.sourceX) / sheet.texture_w;
+		instance.u1 = static_cast<GLfloat>(sheet.atlas_x + emitter.sourceX + emitter.sourceW) / sheet.texture_w;
+		instance.v0 = static_cast<GLfloat>(sheet.atlas_y + emitter.sourceY + emitter.sourceH) / sheet.texture_h;
+		instance.v1 = static_cast<GLfloat>(sheet.atlas_y + emitter.sourceY) / sheet.texture_h;
 	}
-}
-
-void ParticleSystem::update()
-{
-	for (std::vector<Emitter *>::iterator it = emitters.begin(); it != emitters.end();) {
 
-		(*it)->update();
-		if ((*it)->counter2 > (*it)->lifespan && (*it)->particles.empty()) {
-			Emitter * toDelete = (*it);
-			it = emitters.erase(it);
-			delete toDelete;
-		}
-
-		else {
-			it++;
+	// Only interpolate if the particles were updated during the latest simulation tick
+	bool interpolate = updateTick == Core::getSimTicks();
+	float t = Core::getInterpolation();
+	float windowHeight = static_cast<float>(Core::windowHeight());
+	instances.resize(particles.size());
+	for (size_t i = 0; i < particles.size(); ++i) {
+		ParticleInstance& instance = instances[i];
+		instance = emitterInstances[particles.emitter[i]];
+		// Particles are snapped to whole pixels like sprites are
+		if (interpolate) {
+			instance.x = floor(lerp(particles.previousX[i], particles.x[i], t));
+			instance.y = windowHeight - floor(lerp(particles.previousY[i], particles.y[i], t));
+		} else {
+			instance.x = floor(particles.x[i]);
+			instance.y = windowHeight - floor(particles.y[i]);
 		}
 	}
+
+	Core::Renderer::drawParticles(sheet.getTexture(), instances.data(), static_cast<unsigned int>(instances.size()));
 }
 
-void ParticleSystem::addEmitter(Emitter * newEmitter)
+void ParticleSystem::update()
 {
-	emitters.push_back(newEmitter);
-}
+	PROFILE_SCOPE("ParticleSystem::update");
+	updateTick = Core::getSimTicks();
 
+	deaths.clear();
+	particles.update(deaths);
+	for (unsigned int emitter : deaths) {
+		emitters[emitter].particleCount--;
+	}
 
-Emitter::Emitter(int x, int y, int angle, int spread, int maxY, int lifespan, int spawnrate, bool burst, int speed, int pLifeSpan, int spawnRadius, bool gravity) :
-	position(ScreenCoord(x, y)),
-	angle(angle),
-	spread(spread),
-	maxY(maxY),
-	lifespan(lifespan),
-	spawnRate(spawnrate),
-	burst(burst),
-	speed(speed),
-	pLifeSpan(pLifeSpan),
-	spawnRadius(spawnRadius),
-	gravity(gravity)
-{
-	if (burst) {
-		for (int i = 0; i < spawnRate; i++) {
-			ScreenCoord origin;
-			int pAngle;
-			int pMaxY;
-
-			if (spawnRadius == 0) {
-				origin = position;
-			}
-			else {
-				origin = position + ScreenCoord(rand() % (spawnRadius * 2) - spawnRadius, rand() % (spawnRadius * 2) - spawnRadius);
-			}
-
-			if (spread == 0) {
-				pAngle = angle;
-			}
-			else {
-				pAngle = angle + (rand() % (spread * 2) - spread);
-			}
-
-			if (maxY == 0) {
-				pMaxY = 0;
-			}
-			else {
-				pMaxY = origin.y() + maxY + (rand() % (maxY / 2) - (maxY / 4));
-			}
-			int pSpeed = speed + (rand() % speed - (speed / 2));
-			Particle * newParticle = new Particle(origin, pAngle, pMaxY, pSpeed, pLifeSpan, gravity);
-			particles.push_back(newParticle);
+	// Spawning stays on this thread and in emitter order, so it draws the same random numbers as before
+	bool finished = false;
+	for (unsigned int i = 0; i < emitters.size(); ++i) {
+		Emitter& emitter = emitters[i];
+		// Regardless of whether the emitter was burst or not, create more particles
+		emitter.counter++;
+		if (emitter.counter > emitter.spawnRate && emitter.counter2 < emitter.lifespan) {
+			emitter.counter = 0;
+			spawn(i);
 		}
+		emitter.counter2++;
+		finished |= emitter.isFinished();
 	}
+	if (finished) removeFinishedEmitters();
 }
 
-void Emitter::render(Sprite s)
+void ParticleSystem::addEmitter(const Emitter & emitter, ScreenCoord position, int angle)
 {
-	for (Particle * p : particles) {
-		p->render(s);
+	// Removed emitters leave their slots behind, so this only allocates when the system grows
+	emitters.push_back(emitter);
+	unsigned int index = static_cast<unsigned int>(emitters.size()) - 1;
+	emitters[index].position = position;
+	emitters[index].angle = angle;
+	if (emitters[index].burst) {
+		for (int i = 0; i < emitters[index].spawnRate; i++) {
+			spawn(index);
+		}
 	}
 }
 
-void Emitter::update()
+void ParticleSystem::spawn(unsigned int emitterIndex)
 {
-	for (std::vector<Particle *>::iterator it = particles.begin(); it != particles.end();) {
-		(*it)->update();
-		if ((*it)->counter > (*it)->lifespan) {
-			Particle * toDelete = (*it);
-			it = particles.erase(it);
-			delete toDelete;
-		}
+	Emitter& emitter = emitters[emitterIndex];
+	ScreenCoord origin;
+	int pAngle;
+	int pMaxY;
 
-		else {
-			it++;
-		}
+	if (emitter.spawnRadius == 0) {
+		origin = emitter.position;
+	}
+	else {
+		origin = emitter.position + ScreenCoord(rand() % (emitter.spawnRadius * 2) - emitter.spawnRadius, rand() % (emitter.spawnRadius * 2) - emitter.spawnRadius);
 	}
-	// Regardless of whether the particle was burst or not, create more particles
-	counter++;
-	if (counter > spawnRate && counter2 < lifespan) {
-		counter = 0;
-		ScreenCoord origin;
-		int pAngle;
-		int pMaxY;
-
-		if (spawnRadius == 0) {
-			origin = position;
-		}
-		else {
-			origin = position + ScreenCoord(rand() % (spawnRadius * 2) - spawnRadius, rand() % (spawnRadius * 2) - spawnRadius);
-		}
-
-		if (spread == 0) {
-			pAngle = angle;
-		}
-		else {
-			pAngle = angle + (rand() % (spread * 2) - spread);
-		}
 
-		if (maxY == 0) {
-			pMaxY = 0;
-		}
-		else {
-			pMaxY = origin.y() + maxY + (rand() % (maxY / 2) - (maxY / 4));
-		}
+	if (emitter.spread == 0) {
+		pAngle = emitter.angle;
+	}
+	else {
+		pAngle = emitter.angle + (rand() % (emitter.spread * 2) - emitter.spread);
+	}
 
-		int pSpeed = speed + (rand() % speed - (speed / 2));
-		Particle * newParticle = new Particle(origin, pAngle, pMaxY, pSpeed, pLifeSpan, gravity);
-		newParticle->SetSprite(sourceX, sourceY, sourceW, sourceH);
-		particles.push_back(newParticle);
+	if (emitter.maxY == 0) {
+		pMaxY = 0;
+	}
+	else {
+		pMaxY = origin.y() + emitter.maxY + (rand() % (emitter.maxY / 2) - (emitter.maxY / 4));
 	}
-	counter2++;
+
+	int pSpeed = emitter.speed + (rand() % emitter.speed - (emitter.speed / 2));
+	float rad = static_cast<float>(pAngle * (M_PI / 180));
+	particles.add(static_cast<float>(origin.x()), static_cast<float>(origin.y()),
+		sin(rad) * pSpeed, -cos(rad) * pSpeed,
+		emitter.gravity ? PARTICLE_GRAVITY * pSpeed : 0.f,
+		static_cast<float>(pMaxY), emitter.pLifeSpan, emitterIndex);
+	emitter.particleCount++;
 }
 
-void Emitter::SetSprite(int spx, int spy, int ssw, int ssh)
+void ParticleSystem::removeFinishedEmitters()
 {
-	sourceX = spx;
-	sourceY = spy;
-	sourceW = ssw;
-	sourceH = ssh;
-
-	for (Particle * p : particles) {
-		p->SetSprite(spx, spy, ssw, ssh);
+	// Close the gaps in order, then point every particle at the new index of its emitter in one pass
+	emitterRemap.resize(emitters.size());
+	unsigned int kept = 0;
+	for (unsigned int i = 0; i < emitters.size(); ++i) {
+		if (emitters[i].isFinished()) continue;
+		emitterRemap[i] = kept;
+		if (kept != i) emitters[kept] = emitters[i];
+		kept++;
 	}
-}
+	emitters.erase(emitters.begin() + kept, emitters.end());
 
-void Particle::SetSprite(int spx, int spy, int ssw, int ssh)
-{
-	sourceX = spx;
-	sourceY = spy;
-	sourceW = ssw;
-	sourceH = ssh;
+	// Finished emitters have no particles left, so every particle has a remapped index
+	for (unsigned int& emitter : particles.emitter) {
+		emitter = emitterRemap[emitter];
+	}
 }
 
-
-Particle::Particle(ScreenCoord origin, int angle, int maxY, int speed, int lifespan, bool gravity) :
-	position(origin),
-	approxX(origin.x()),
-	approxY(origin.y()),
+Emitter::Emitter(int x, int y, int angle, int spread, int maxY, int lifespan, int spawnrate, bool burst, int speed, int pLifeSpan, int spawnRadius, bool gravity) :
+	position(ScreenCoord(x, y)),
+	angle(angle),
+	spread(spread),
 	maxY(maxY),
-	speed(speed),
 	lifespan(lifespan),
-	gravity(gravity)
+	counter2(0),
+	spawnRate(spawnrate),
+	counter(0),
+	burst(burst),
+	speed(speed),
+	pLifeSpan(pLifeSpan),
+	spawnRadius(spawnRadius),
+	sourceX(0),
+	sourceY(0),
+	sourceW(0),
+	sourceH(0),
+	gravity(gravity),
+	particleCount(0)
 {
-	double rad = angle * (M_PI / 180);
-	velocity = Vec2<double>(sin(rad), -cos(rad));
-	counter = 0;
-}
 
-void Particle::render(Sprite s)
-{
-	s.setPos(position.x(), position.y());
-	s.setSourcePos(sourceX, sourceY);
-	s.setSourceSize(sourceW, sourceH);
-	//s.setSize(100, 100);
-	s.render();
 }
 
-void Particle::update()
+void Emitter::SetSprite(int spx, int spy, int ssw, int ssh)
 {
-	if (!gravity) {
-		counter++;
-		approxX += velocity.x()*speed;
-		approxY += velocity.y()*speed;
-
-		position.x() = static_cast<int>(floor(approxX));
-		position.y() = static_cast<int>(floor(approxY));
-	}
-	else {
-		if (position.y() < maxY) {
-			approxX += velocity.x()*speed;
-			approxY += velocity.y()*speed;
-
-			velocity += G;
-
-			position.x() = static_cast<int>(floor(approxX));
-			position.y() = static_cast<int>(floor(approxY));
-		}
-		else {
-			counter++;
-		}
-	}
+	sourceX = spx;
+	sourceY = spy;
+	sourceW = ssw;
+	sourceH = ssh;
 }
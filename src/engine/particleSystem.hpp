@@ -1,56 +1,27 @@
 #pragma once
-#pragma once
 
 #include "../engine/core.hpp"
+#include "particlePool.hpp"
 #include <math.h>
 #include <stdlib.h>
 
+#include <vector>
 
-class Particle {
-public:
-	//Particle(ScreenCoord origin, int angle, int maxY, int speed);
-	Particle(ScreenCoord origin, int angle, int maxY, int speed, int lifespan, bool gravity);
-
-	void render(Sprite s);
-	void update();
-	void SetSprite(int spx, int spy, int ssw, int ssh);
-
-	ScreenCoord position;
-
-	double approxX;
-	double approxY;
-
-	Vec2<double> velocity;
-	Vec2<double> G = Vec2<double>(0, .1);
-	double speed;
-
-	int lifespan;
-	int counter;
-
-	int maxY;
-
-	int sourceX;
-	int sourceY;
-	int sourceW;
-	int sourceH;
-
-	bool gravity;
-
-};
+// Added to the velocity of gravity particles every tick, scaled by the speed of the particle
+#define PARTICLE_GRAVITY	0.1f
+// Width and height of a particle on screen
+#define PARTICLE_SIZE		30.f
 
+/*	Settings and spawn state of a particle emitter
+		- Emitters don't own any particles, the particles live in the pool of the particle system
+			the emitter is added to
+*/
 class Emitter {
 public:
-	//Emitter(int x, int y, int angle, int spread, int maxY, int lifespan, int spawnrate, bool burst);
 	Emitter(int x, int y, int angle, int spread, int maxY, int lifespan, int spawnrate, bool burst, int speed, int pLifeSpan, int spawnRadius, bool gravity);
 
-	void render(Sprite s);
-	void update();
-
-	std::vector<Particle *> particles;
 	void SetSprite(int spx, int spy, int ssw, int ssh);
 
-
-
 	ScreenCoord position;
 	int angle;
 	int spread;
@@ -71,9 +42,18 @@ public:
 
 	bool gravity;
 
-};
+	// Number of particles spawned by the emitter that are still alive
+	unsigned int particleCount;
+
+	// Done spawning and every particle it spawned has died
+	inline bool isFinished() const { return counter2 > lifespan && particleCount == 0; }
 
+};
 
+/*	Simulates and draws the particles of a set of emitters
+		- Rendering writes one instance per particle straight from the pool and draws the whole
+			system with a single instanced draw, there are no sprites involved per particle
+*/
 class ParticleSystem {
 public:
 	ParticleSystem();
@@ -82,9 +62,29 @@ public:
 	void render();
 	void update();
 
-	std::vector<Emitter *> emitters;
-	void addEmitter(Emitter * newEmitter);
+	// Copies a template emitter into the system and moves it to the position and angle
+	// Burst emitters spawn all their particles right away
+	void addEmitter(const Emitter& emitter, ScreenCoord position, int angle);
+	inline size_t getParticleCount() const { return particles.size(); }
 
-	Sprite sprite;
-};
+	std::vector<Emitter> emitters;
+	ParticlePool particles;
 
+	// Texture and atlas placement of the particle sheet, the sprite itself is never drawn
+	Sprite sheet;
+
+private:
+	void spawn(unsigned int emitterIndex);
+	// Removes every finished emitter at once, so the particles are only renumbered once per update
+	void removeFinishedEmitters();
+
+	// Simulation tick of the last update, rendering only interpolates right after an update
+	unsigned int updateTick;
+	std::vector<unsigned int> deaths;
+	// New index of every emitter while finished emitters are removed
+	std::vector<unsigned int> emitterRemap;
+
+	// Reused between frames so rendering doesn't allocate once the system has grown
+	std::vector<ParticleInstance> instances;
+	std::vector<ParticleInstance> emitterInstances;
+};
@@ -0,0 +1,86 @@
+#include "particleWorkers.hpp"
+
+#include <algorithm>
+
+ParticleWorkers::ParticleWorkers() :
+	m_stopping(false),
+	m_job(nullptr),
+	m_next(0),
+	m_chunkCount(0),
+	m_remaining(0),
+	m_threshold(PARTICLE_PARALLEL_THRESHOLD)
+{
+	// hardware_concurrency may not know and return 0
+	setThreadCount(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+ParticleWorkers::~ParticleWorkers() {
+	stop();
+}
+
+void ParticleWorkers::setThreadCount(unsigned int count) {
+	stop();
+	count = std::min(std::max(count, 1u), static_cast<unsigned int>(PARTICLE_MAX_THREADS));
+	m_stopping = false;
+	for (unsigned int i = 1; i < count; ++i) {
+		m_workers.emplace_back(&ParticleWorkers::worker, this);
+	}
+}
+
+unsigned int ParticleWorkers::getChunkCount(size_t count) const {
+	if (count < m_threshold) return 1;
+	size_t chunks = std::min(count / PARTICLE_MIN_CHUNK, static_cast<size_t>(getThreadCount()));
+	return static_cast<unsigned int>(std::max(chunks, static_cast<size_t>(1)));
+}
+
+void ParticleWorkers::run(unsigned int chunkCount, const std::function<void(unsigned int)>& job) {
+	// Waking the workers isn't worth it for a single chunk
+	if (chunkCount <= 1 || m_workers.empty()) {
+		for (unsigned int chunk = 0; chunk < chunkCount; ++chunk) {
+			job(chunk);
+		}
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_job = &job;
+	m_next = 0;
+	m_chunkCount = chunkCount;
+	m_remaining = chunkCount;
+	m_condition.notify_all();
+	runChunks(lock);
+	m_done.wait(lock, [this]() { return m_remaining == 0; });
+	m_job = nullptr;
+}
+
+void ParticleWorkers::worker() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		m_condition.wait(lock, [this]() { return m_stopping || m_next < m_chunkCount; });
+		if (m_stopping) return;
+		runChunks(lock);
+	}
+}
+
+void ParticleWorkers::runChunks(std::unique_lock<std::mutex>& lock) {
+	// Chunks are handed out under the lock, so a late worker can never pick up a finished job
+	while (m_next < m_chunkCount) {
+		unsigned int chunk = m_next++;
+		lock.unlock();
+		(*m_job)(chunk);
+		lock.lock();
+		if (--m_remaining == 0) m_done.notify_all();
+	}
+}
+
+void ParticleWorkers::stop() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+	for (std::thread& worker : m_workers) {
+		worker.join();
+	}
+	m_workers.clear();
+}
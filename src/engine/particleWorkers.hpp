@@ -0,0 +1,71 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Upper limit of threads that update particles, the calling thread included
+#define PARTICLE_MAX_THREADS		8
+// Particle pools smaller than this are updated on the calling thread only
+#define PARTICLE_PARALLEL_THRESHOLD	20000
+// Fewest particles worth handing to another thread, a multiple of the widest kernel
+#define PARTICLE_MIN_CHUNK			4096
+
+/*	Threads that particle updates are split across
+		- A job is cut into chunks which the workers and the calling thread take in turns,
+			run only returns once every chunk is done
+		- Which thread runs a chunk doesn't matter, callers keep their chunks independent
+			and merge the results in chunk order so the outcome is the same on any core count
+*/
+class ParticleWorkers {
+
+public:
+	// Accessor method for singleton pattern
+	static ParticleWorkers& get_instance() {
+		static ParticleWorkers workers;
+		return workers;
+	}
+
+	// Delete copy and move constructors and assign operators
+	ParticleWorkers(ParticleWorkers const&) = delete;             // Copy construct
+	ParticleWorkers(ParticleWorkers&&) = delete;                  // Move construct
+	ParticleWorkers& operator=(ParticleWorkers const&) = delete;  // Copy assign
+	ParticleWorkers& operator=(ParticleWorkers &&) = delete;      // Move assign
+
+	// Call job for every chunk in [0, chunkCount)
+	void run(unsigned int chunkCount, const std::function<void(unsigned int)>& job);
+
+	// Number of chunks to split count particles into, 1 below the parallel threshold
+	unsigned int getChunkCount(size_t count) const;
+
+	// Threads including the calling one
+	inline unsigned int getThreadCount() const { return static_cast<unsigned int>(m_workers.size()) + 1; }
+	void setThreadCount(unsigned int count);
+	inline size_t getThreshold() const { return m_threshold; }
+	inline void setThreshold(size_t count) { m_threshold = count; }
+
+private:
+	ParticleWorkers();
+	~ParticleWorkers();
+
+	void worker();
+	// Take chunks of the current job until there are none left, the lock is held between chunks
+	void runChunks(std::unique_lock<std::mutex>& lock);
+	void stop();
+
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::condition_variable m_done;
+	bool m_stopping;
+
+	// The job being run, the next chunk to hand out and the chunks that haven't finished
+	const std::function<void(unsigned int)> * m_job;
+	unsigned int m_next;
+	unsigned int m_chunkCount;
+	unsigned int m_remaining;
+
+	size_t m_threshold;
+};
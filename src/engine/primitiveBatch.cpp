@@ -0,0 +1,129 @@
+#include "primitiveBatch.hpp"
+
+#include <algorithm>
+
+#include "engine.hpp"
+
+// Unit meshes that get stretched over the origin and size of every instance
+const GLfloat RECT_VERTICES[12] = {
+	0.0f, 1.0f,
+	1.0f, 0.0f,
+	0.0f, 0.0f,
+
+	0.0f, 1.0f,
+	1.0f, 1.0f,
+	1.0f, 0.0f
+};
+const GLfloat LINE_VERTICES[4] = {
+	0.0f, 0.0f,
+	1.0f, 1.0f
+};
+
+PrimitiveBatch::PrimitiveBatch() :
+	shader("res/shaders/primitive_vertex.glsl", "res/shaders/primitive_fragment.glsl"),
+	currentType(PrimitiveType::RECT),
+	primitiveCount(0)
+{
+	instances.reserve(PRIMITIVE_BATCH_MAX_PRIMITIVES);
+
+	glGenBuffers(1, &instanceVBO);
+	RenderStats::get_instance().add(RenderStat::BUFFER_CREATIONS);
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(PrimitiveInstance) * PRIMITIVE_BATCH_MAX_PRIMITIVES, nullptr, GL_STREAM_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	initMesh(rectVAO, rectVBO, RECT_VERTICES, sizeof(RECT_VERTICES));
+	initMesh(lineVAO, lineVBO, LINE_VERTICES, sizeof(LINE_VERTICES));
+}
+
+PrimitiveBatch::~PrimitiveBatch() {
+	glDeleteBuffers(1, &rectVBO);
+	glDeleteBuffers(1, &lineVBO);
+	glDeleteBuffers(1, &instanceVBO);
+	glDeleteVertexArrays(1, &rectVAO);
+	glDeleteVertexArrays(1, &lineVAO);
+}
+
+void PrimitiveBatch::begin() {
+	instances.clear();
+}
+
+void PrimitiveBatch::submitRect(ScreenCoord v, int width, int height, Colour colour, float alpha) {
+	GLfloat top = static_cast<GLfloat>(Engine::get_instance().getWindowHeight() - v.y());
+	alpha = std::min(1.f, std::max(0.f, alpha));
+	submit(PrimitiveType::RECT, PrimitiveInstance{
+		static_cast<GLfloat>(v.x()), top,
+		static_cast<GLfloat>(width), -static_cast<GLfloat>(height),
+		colour.r(), colour.g(), colour.b(), alpha
+	});
+}
+
+void PrimitiveBatch::submitLine(ScreenCoord v1, ScreenCoord v2, Colour colour, float alpha) {
+	GLfloat top = static_cast<GLfloat>(Engine::get_instance().getWindowHeight() - v1.y());
+	alpha = std::min(1.f, std::max(0.f, alpha));
+	submit(PrimitiveType::LINE, PrimitiveInstance{
+		static_cast<GLfloat>(v1.x()), top,
+		static_cast<GLfloat>(v2.x() - v1.x()), -static_cast<GLfloat>(v2.y() - v1.y()),
+		colour.r(), colour.g(), colour.b(), alpha
+	});
+}
+
+void PrimitiveBatch::submit(PrimitiveType type, const PrimitiveInstance & instance) {
+	// Cut a new batch if the mesh changes or there is no more room in the buffer
+	if (type != currentType || instances.size() >= PRIMITIVE_BATCH_MAX_PRIMITIVES) {
+		flush();
+		currentType = type;
+	}
+	instances.push_back(instance);
+	primitiveCount++;
+}
+
+void PrimitiveBatch::flush() {
+	if (instances.empty()) return;
+
+	shader.bind();
+
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	// Orphan the old buffer storage so the driver doesn't stall on the previous draw
+	glBufferData(GL_ARRAY_BUFFER, sizeof(PrimitiveInstance) * PRIMITIVE_BATCH_MAX_PRIMITIVES, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(PrimitiveInstance) * instances.size(), instances.data());
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	GLsizei count = currentType == PrimitiveType::RECT ? 6 : 2;
+	glBindVertexArray(currentType == PrimitiveType::RECT ? rectVAO : lineVAO);
+	glDrawArraysInstanced(currentType == PrimitiveType::RECT ? GL_TRIANGLES : GL_LINES, 0, count, static_cast<GLsizei>(instances.size()));
+	glBindVertexArray(0);
+	RenderStats::get_instance().add(RenderStat::DRAW_CALLS);
+	RenderStats::get_instance().add(RenderStat::VERTICES, count * static_cast<unsigned int>(instances.size()));
+
+	instances.clear();
+}
+
+void PrimitiveBatch::resetStats() {
+	primitiveCount = 0;
+}
+
+void PrimitiveBatch::initMesh(GLuint & VAO, GLuint & VBO, const GLfloat * vertices, unsigned int size) {
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	RenderStats::get_instance().add(RenderStat::BUFFER_CREATIONS, 2);
+
+	glBindVertexArray(VAO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (void*)0);
+
+	// The instance attributes advance once per primitive instead of once per vertex
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(PrimitiveInstance), (void*)0);
+	glVertexAttribDivisor(1, 1);
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(PrimitiveInstance), (void*)(4 * sizeof(GLfloat)));
+	glVertexAttribDivisor(2, 1);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
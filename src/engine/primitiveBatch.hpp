@@ -0,0 +1,73 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+#include "opengl/glwrappers.hpp"
+#include "../math/math.hpp"
+
+// The maximum number of primitives that can be queued before the batch is forced to flush
+#define PRIMITIVE_BATCH_MAX_PRIMITIVES	4096
+
+// Per instance data of a batched rectangle or line
+struct PrimitiveInstance {
+	// Origin and size in screen space, the unit mesh is stretched over it
+	GLfloat x, y;
+	GLfloat w, h;
+	GLfloat r, g, b, a;
+};
+
+enum class PrimitiveType {
+	RECT,
+	LINE
+};
+
+/*	An instanced batcher for solid colour rectangles and lines
+		- Each primitive is stored as one instance of a unit quad or unit line,
+			so a whole run of primitives is drawn with a single instanced draw call
+		- Colour and alpha are stored per primitive, so changing them doesn't break the batch
+		- Rectangles and lines are drawn with different meshes, so the batch is flushed
+			whenever the primitive type changes to keep the submission order
+
+	Usage:
+		- begin() at the start of a frame
+		- submitRect() / submitLine() for every primitive
+		- flush() before drawing anything that doesn't go through the batch and at the end of the frame
+*/
+class PrimitiveBatch {
+
+public:
+	PrimitiveBatch();
+	~PrimitiveBatch();
+
+	void begin();
+	void submitRect(ScreenCoord v, int width, int height, Colour colour, float alpha);
+	void submitLine(ScreenCoord v1, ScreenCoord v2, Colour colour, float alpha);
+	void flush();
+
+	// Number of primitives submitted since the last reset
+	inline unsigned int getPrimitiveCount() const { return primitiveCount; }
+	void resetStats();
+
+private:
+	void submit(PrimitiveType type, const PrimitiveInstance& instance);
+
+	// The shader used to draw every batched primitive
+	Shader shader;
+
+	// Unit meshes of each primitive type, both sharing the instance buffer
+	GLuint rectVAO, rectVBO;
+	GLuint lineVAO, lineVBO;
+	GLuint instanceVBO;
+
+	// CPU side storage of the queued instances
+	std::vector<PrimitiveInstance> instances;
+	// The type all of the currently queued instances are drawn as
+	PrimitiveType currentType;
+
+	// Statistics since the last reset
+	unsigned int primitiveCount;
+
+	void initMesh(GLuint& VAO, GLuint& VBO, const GLfloat * vertices, unsigned int size);
+};
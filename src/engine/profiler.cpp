@@ -0,0 +1,77 @@
+#include "profiler.hpp"
+
+#include <fstream>
+
+Profiler::Profiler() :
+	events(new ProfileEvent[PROFILER_BUFFER_SIZE]),
+	writeIndex(0),
+	frame(0),
+	enabled(true)
+{
+	for (unsigned int i = 0; i < PROFILER_BUFFER_SIZE; ++i) {
+		events[i].sequence.store(0, std::memory_order_relaxed);
+	}
+}
+
+Profiler::~Profiler() {
+
+}
+
+void Profiler::record(const char * name, Uint64 start, Uint64 end) {
+	if (!enabled.load(std::memory_order_relaxed)) return;
+
+	// Claim a slot, old events are overwritten once the buffer wraps around
+	Uint64 index = writeIndex.fetch_add(1, std::memory_order_relaxed);
+	ProfileEvent& event = events[index & (PROFILER_BUFFER_SIZE - 1)];
+	// Mark the slot as being written, the fence keeps the data writes from moving ahead of the mark
+	event.sequence.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	event.name.store(name, std::memory_order_relaxed);
+	event.start.store(start, std::memory_order_relaxed);
+	event.end.store(end, std::memory_order_relaxed);
+	event.thread.store(getThreadId(), std::memory_order_relaxed);
+	event.frame.store(frame.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	event.sequence.store(index + 1, std::memory_order_release);
+}
+
+bool Profiler::writeTrace(const std::string & path) const {
+	std::ofstream file(path);
+	if (!file.is_open()) return false;
+
+	double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+	Uint64 end = writeIndex.load(std::memory_order_acquire);
+	Uint64 begin = end > PROFILER_BUFFER_SIZE ? end - PROFILER_BUFFER_SIZE : 0;
+
+	file << "{\"traceEvents\":[";
+	bool first = true;
+	for (Uint64 index = begin; index < end; ++index) {
+		const ProfileEvent& event = events[index & (PROFILER_BUFFER_SIZE - 1)];
+		// Skip events that are still being written or were overwritten
+		if (event.sequence.load(std::memory_order_acquire) != index + 1) continue;
+		const char * name = event.name.load(std::memory_order_relaxed);
+		Uint64 start = event.start.load(std::memory_order_relaxed);
+		Uint64 stop = event.end.load(std::memory_order_relaxed);
+		unsigned int thread = event.thread.load(std::memory_order_relaxed);
+		unsigned int eventFrame = event.frame.load(std::memory_order_relaxed);
+		// The fence keeps the data reads from moving after the second check
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (event.sequence.load(std::memory_order_relaxed) != index + 1) continue;
+
+		// Timestamps in the trace format are in microseconds
+		double ts = static_cast<double>(start) * 1000000.0 / frequency;
+		double dur = static_cast<double>(stop - start) * 1000000.0 / frequency;
+		if (!first) file << ",";
+		first = false;
+		file << "\n{\"name\":\"" << name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+			<< ",\"ts\":" << std::fixed << ts << ",\"dur\":" << dur
+			<< ",\"args\":{\"frame\":" << eventFrame << "}}";
+	}
+	file << "\n]}\n";
+	return true;
+}
+
+unsigned int Profiler::getThreadId() {
+	static std::atomic<unsigned int> nextId(0);
+	thread_local unsigned int id = nextId++;
+	return id;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+// Number of events kept in the ring buffer, has to be a power of two
+#define PROFILER_BUFFER_SIZE	(1 << 16)
+
+// Helper macros to generate a unique variable name for every scope
+#define PROFILE_CONCAT_INNER(a, b) a ## b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Time the rest of the enclosing scope, the name has to be a string literal
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+
+// A single timed scope
+// The fields are atomic since a slot can be rewritten while writeTrace reads it, the sequence tells if the read was torn
+struct ProfileEvent {
+	std::atomic<const char *> name;
+	std::atomic<Uint64> start;
+	std::atomic<Uint64> end;
+	std::atomic<unsigned int> thread;
+	std::atomic<unsigned int> frame;
+	// Stamped last so readers can tell if the event was completely written
+	std::atomic<Uint64> sequence;
+};
+
+/*	A CPU profiler for timing scopes in the engine and the game
+		- Use PROFILE_SCOPE("name") at the start of a scope to time the rest of it
+		- Events are written into a fixed size ring buffer, writers only need an atomic increment
+			to claim a slot so any thread can record events without locking
+		- Nested scopes on the same thread show up as a hierarchy in the trace viewer
+		- writeTrace() exports the events in the Chrome trace format, which can be opened
+			in chrome://tracing or Perfetto
+*/
+class Profiler {
+
+public:
+	// Accessor method for singleton pattern
+	static Profiler& get_instance() {
+		static Profiler profiler;
+		return profiler;
+	}
+
+	// Delete copy and move constructors and assign operators
+	Profiler(Profiler const&) = delete;             // Copy construct
+	Profiler(Profiler&&) = delete;                  // Move construct
+	Profiler& operator=(Profiler const&) = delete;  // Copy assign
+	Profiler& operator=(Profiler &&) = delete;      // Move assign
+
+	void record(const char * name, Uint64 start, Uint64 end);
+	// Marks the start of a new frame so events can be grouped by frame
+	inline void nextFrame() { frame++; }
+
+	inline void setEnabled(bool enabled) { this->enabled = enabled; }
+	inline bool isEnabled() const { return enabled; }
+
+	// Write every event still in the ring buffer to a Chrome trace JSON file
+	bool writeTrace(const std::string& path) const;
+
+protected:
+	Profiler();
+	~Profiler();
+
+private:
+
+	std::unique_ptr<ProfileEvent[]> events;
+	std::atomic<Uint64> writeIndex;
+	std::atomic<unsigned int> frame;
+	std::atomic<bool> enabled;
+
+	// Every thread that records events gets a small id for the trace
+	static unsigned int getThreadId();
+
+};
+
+// Records the time between construction and destruction of the object
+class ProfileScope {
+
+public:
+	ProfileScope(const char * name) : name(name), start(SDL_GetPerformanceCounter()) {}
+	~ProfileScope() { Profiler::get_instance().record(name, start, SDL_GetPerformanceCounter()); }
+
+private:
+	const char * name;
+	Uint64 start;
+
+};
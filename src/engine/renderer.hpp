@@ -3,38 +3,91 @@
 #include <GL/glew.h>
 
 #include "opengl/glwrappers.hpp"
+#include "spriteBatch.hpp"
+#include "primitiveBatch.hpp"
+#include "particleBatch.hpp"
 #include "../math/math.hpp"
 
 class Sprite;
+class SpriteMesh;
 
-class Renderer {
+// Vertex strides of the streamed draws, position only and position + texture coordinate
+#define STREAM_COLOUR_STRIDE	(2 * sizeof(GLfloat))
+#define STREAM_TEXTURE_STRIDE	(4 * sizeof(GLfloat))
+
+// Interface of the rendering backend, so the engine can run without a GPU
+class BaseRenderer {
+
+public:
+	virtual ~BaseRenderer() {}
+
+	virtual void clear() const = 0;
+	virtual void drawLine_fast(ScreenCoord v1, ScreenCoord v2, Colour colour, float alpha = 1.f) = 0;
+	virtual void drawLine(ScreenCoord v1, ScreenCoord v2, Colour colour, float alpha = 1.f) = 0;
+	virtual void drawRect_fast(ScreenCoord v, int width, int height, Colour colour, float alpha = 1.f) = 0;
+	virtual void drawRect(ScreenCoord v, int width, int height, Colour colour, float alpha = 1.f) = 0;
+	virtual void drawTexture(ScreenCoord v, int width, int height, const Texture& texture) = 0;
+	virtual void drawSprite_fast(const Sprite& sprite) = 0;
+	virtual void drawSprite(const Sprite& sprite) = 0;
+	virtual void drawSpriteMesh(const SpriteMesh& mesh, const Texture& texture) = 0;
+	virtual void drawParticles(const Texture& texture, const ParticleInstance * instances, unsigned int count) = 0;
+
+	// Frame functions to manage sprite and primitive batching
+	virtual void beginFrame() = 0;
+	virtual void endFrame() = 0;
+	virtual void flush() = 0;
+
+	// Number of sprites and primitives submitted during the last complete frame
+	virtual unsigned int getSpriteCount() const = 0;
+	virtual unsigned int getPrimitiveCount() const = 0;
+};
+
+// The OpenGL renderer
+class Renderer : public BaseRenderer {
 
 public:
 	Renderer();
 
-	void clear() const;
-	void drawLine_fast(ScreenCoord v1, ScreenCoord v2, Colour colour);
-	void drawLine(ScreenCoord v1, ScreenCoord v2, Colour colour);
-	void drawRect_fast(ScreenCoord v, int width, int height, Colour colour);
-	void drawRect(ScreenCoord v, int width, int height, Colour colour);
-	void drawTexture(ScreenCoord v, int width, int height, const Texture& texture);
-	void drawSprite_fast(const Sprite& sprite);
-	void drawSprite(const Sprite& sprite);
-	void setAlpha(float a);
+	void clear() const override;
+	void drawLine_fast(ScreenCoord v1, ScreenCoord v2, Colour colour, float alpha = 1.f) override;
+	void drawLine(ScreenCoord v1, ScreenCoord v2, Colour colour, float alpha = 1.f) override;
+	void drawRect_fast(ScreenCoord v, int width, int height, Colour colour, float alpha = 1.f) override;
+	void drawRect(ScreenCoord v, int width, int height, Colour colour, float alpha = 1.f) override;
+	void drawTexture(ScreenCoord v, int width, int height, const Texture& texture) override;
+	void drawSprite_fast(const Sprite& sprite) override;
+	void drawSprite(const Sprite& sprite) override;
+	void drawSpriteMesh(const SpriteMesh& mesh, const Texture& texture) override;
+	// Draws the particles right away as instances of one quad, count is not limited by the batch size
+	void drawParticles(const Texture& texture, const ParticleInstance * instances, unsigned int count) override;
+
+	// Frame functions to manage sprite and primitive batching
+	void beginFrame() override;
+	void endFrame() override;
+	void flush() override;
+
+	// Number of sprites and primitives submitted during the last complete frame, everything else is counted in RenderStats
+	inline unsigned int getSpriteCount() const override { return lastSpriteCount; }
+	inline unsigned int getPrimitiveCount() const override { return lastPrimitiveCount; }
 private:
-	void drawTriangles(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
-	void drawLines(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
-	void drawLineStrip(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
-	void draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, GLenum type) const;
+	// Stream the vertices into the ring buffer and draw them with the given layout
+	void drawStream(const void * data, unsigned int size, GLuint vao, GLsizei stride, GLenum type, const Shader& shader);
 
 	// static shaders for sprite and solid fill drawing
 	Shader basicShader;
 	Shader textureShader;
 
-	void initRectangleData();
-	void initLineData();
-	GLuint rectangleVAO_;
-	GLuint lineVAO_;
+	// Streaming storage for the slow draw paths, shared by a vertex array for each layout
+	void initStreamData();
+	StreamBuffer streamBuffer;
+	GLuint streamColourVAO_;
+	GLuint streamTextureVAO_;
+
+	// Batchers that all the fast sprite, rect and line draws are queued into
+	SpriteBatch spriteBatch;
+	PrimitiveBatch primitiveBatch;
+	ParticleBatch particleBatch;
 
-	float alpha = 1;
+	// Counters of the last frame, the batches keep track of the current one
+	unsigned int lastSpriteCount = 0;
+	unsigned int lastPrimitiveCount = 0;
 };
\ No newline at end of file
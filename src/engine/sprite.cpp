@@ -3,20 +3,75 @@
 #include "core.hpp"
 
 Sprite::Sprite(const std::string & path) : 
-	texture(path),
+	texture(INVALID_TEXTURE_HANDLE),
 	x(0), y(0),
 	w(0), h(0),
 	src_x(0), src_y(0),
 	src_w(0), src_h(0),
 	original_w(0),
-	original_h(0)
+	original_h(0),
+	atlas_x(0), atlas_y(0),
+	texture_w(0), texture_h(0)
 {
-	src_w = original_w = w = Core::getTexture(path)->getWidth();
-	src_h = original_h = h = Core::getTexture(path)->getHeight();
+	// Packed images are drawn from their region of the atlas page instead of their own texture
+	const AtlasRegion * region = Core::getAtlasRegion(path);
+	texture = Core::getTextureHandle(region ? region->page : path);
+	// The texture itself may still be decoding, so take the size from the texture manager
+	Vec2<int> size = Core::getImageSize(texture);
+	texture_w = size.x();
+	texture_h = size.y();
+	if (region) {
+		src_w = original_w = w = region->w;
+		src_h = original_h = h = region->h;
+		atlas_x = region->x;
+		atlas_y = texture_h - region->y - region->h;
+	}
+	else {
+		src_w = original_w = w = texture_w;
+		src_h = original_h = h = texture_h;
+	}
+	// Keep the texture from being evicted while the sprite is alive
+	Core::addTextureRef(texture);
 }
 
-Sprite::~Sprite() {
+Sprite::Sprite(const Sprite & other) :
+	texture(other.texture),
+	x(other.x), y(other.y),
+	w(other.w), h(other.h),
+	src_x(other.src_x), src_y(other.src_y),
+	src_w(other.src_w), src_h(other.src_h),
+	original_w(other.original_w),
+	original_h(other.original_h),
+	atlas_x(other.atlas_x), atlas_y(other.atlas_y),
+	texture_w(other.texture_w), texture_h(other.texture_h)
+{
+	Core::addTextureRef(texture);
+}
 
+Sprite & Sprite::operator=(const Sprite & other) {
+	// Take the new reference first in case both sprites share the texture
+	Core::addTextureRef(other.texture);
+	Core::releaseTexture(texture);
+	texture = other.texture;
+	x = other.x;
+	y = other.y;
+	w = other.w;
+	h = other.h;
+	src_x = other.src_x;
+	src_y = other.src_y;
+	src_w = other.src_w;
+	src_h = other.src_h;
+	original_w = other.original_w;
+	original_h = other.original_h;
+	atlas_x = other.atlas_x;
+	atlas_y = other.atlas_y;
+	texture_w = other.texture_w;
+	texture_h = other.texture_h;
+	return *this;
+}
+
+Sprite::~Sprite() {
+	Core::releaseTexture(texture);
 }
 
 void Sprite::render() {
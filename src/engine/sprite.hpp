@@ -1,12 +1,16 @@
 #pragma once
 
 #include "opengl/glwrappers.hpp"
+#include "textureManager.hpp"
 
 class Sprite {
 
 public:
 
 	Sprite(const std::string& path);
+	// Copies hold their own reference to the texture
+	Sprite(const Sprite& other);
+	Sprite& operator=(const Sprite& other);
 	~Sprite();
 
 	virtual void render();
@@ -26,6 +30,11 @@ public:
 	// TODO: FIND A MORE ELEGANT SOLUTION FOR THIS
 	int original_w, original_h;
 
+	// Where the image is inside its texture, only differs from the original image if it is packed into an atlas
+	// The offset is in the flipped texture space, measured from the bottom left
+	int atlas_x, atlas_y;
+	int texture_w, texture_h;
+
 	// helper methods to make life easier
 	void setPos(int x, int y);
 	void setSize(int w, int h);
@@ -34,6 +43,7 @@ public:
 
 private:
 
-	std::string texture;
+	// Resolved once on construction so drawing never has to look up the path
+	TextureHandle texture;
 
 };
\ No newline at end of file
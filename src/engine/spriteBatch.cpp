@@ -0,0 +1,133 @@
+#include "spriteBatch.hpp"
+
+#include "engine.hpp"
+#include "sprite.hpp"
+#include "spriteMesh.hpp"
+
+SpriteBatch::SpriteBatch() :
+	shader("res/shaders/batch_vertex.glsl", "res/shaders/basic_texture.glsl"),
+	currentTexture(nullptr),
+	spriteCount(0)
+{
+	vertices.reserve(SPRITE_BATCH_MAX_SPRITES * 4);
+
+	// Every quad uses the same index pattern, so the index buffer only needs to be generated once
+	std::vector<GLuint> indices;
+	indices.reserve(SPRITE_BATCH_MAX_SPRITES * 6);
+	for (GLuint i = 0; i < SPRITE_BATCH_MAX_SPRITES; ++i) {
+		GLuint base = i * 4;
+		indices.push_back(base + 3);
+		indices.push_back(base + 1);
+		indices.push_back(base + 0);
+		indices.push_back(base + 3);
+		indices.push_back(base + 2);
+		indices.push_back(base + 1);
+	}
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &IBO);
+	RenderStats::get_instance().add(RenderStat::BUFFER_CREATIONS, 3);
+
+	glBindVertexArray(VAO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(SpriteVertex) * SPRITE_BATCH_MAX_SPRITES * 4, nullptr, GL_STREAM_DRAW);
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * indices.size(), indices.data(), GL_STATIC_DRAW);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)0);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)(2 * sizeof(GLfloat)));
+
+	// Unbind the vertex array first so it keeps its reference to the index buffer
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+SpriteBatch::~SpriteBatch() {
+	glDeleteBuffers(1, &VBO);
+	glDeleteBuffers(1, &IBO);
+	glDeleteVertexArrays(1, &VAO);
+}
+
+void SpriteBatch::begin() {
+	vertices.clear();
+	currentTexture = nullptr;
+}
+
+void SpriteBatch::submit(const Sprite & sprite) {
+	const Texture * texture = &sprite.getTexture();
+	// Cut a new batch if the texture changes or there is no more room in the buffer
+	if (texture != currentTexture || vertices.size() >= SPRITE_BATCH_MAX_SPRITES * 4) {
+		flush();
+		currentTexture = texture;
+	}
+
+	vertices.resize(vertices.size() + 4);
+	writeQuad(sprite, &vertices[vertices.size() - 4]);
+
+	spriteCount++;
+}
+
+void SpriteBatch::flush() {
+	if (vertices.empty() || !currentTexture) return;
+
+	shader.bind();
+	currentTexture->bind();
+
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	// Orphan the old buffer storage so the driver doesn't stall on the previous draw
+	glBufferData(GL_ARRAY_BUFFER, sizeof(SpriteVertex) * SPRITE_BATCH_MAX_SPRITES * 4, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(SpriteVertex) * vertices.size(), vertices.data());
+
+	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(vertices.size() / 4 * 6), GL_UNSIGNED_INT, nullptr);
+	RenderStats::get_instance().add(RenderStat::DRAW_CALLS);
+	RenderStats::get_instance().add(RenderStat::VERTICES, static_cast<unsigned int>(vertices.size()));
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+
+	vertices.clear();
+}
+
+void SpriteBatch::drawMesh(const SpriteMesh & mesh, const Texture & texture) {
+	flush();
+	if (mesh.empty()) return;
+
+	shader.bind();
+	texture.bind();
+
+	mesh.bind();
+	glDrawArrays(GL_TRIANGLES, 0, mesh.getVertexCount());
+	glBindVertexArray(0);
+	RenderStats::get_instance().add(RenderStat::DRAW_CALLS);
+	RenderStats::get_instance().add(RenderStat::VERTICES, mesh.getVertexCount());
+}
+
+void SpriteBatch::writeQuad(const Sprite & sprite, SpriteVertex * out) {
+	// Same transformation that the old per sprite model/texture matrices did
+	GLfloat left = static_cast<GLfloat>(sprite.x);
+	GLfloat right = static_cast<GLfloat>(sprite.x + sprite.w);
+	GLfloat top = static_cast<GLfloat>(Engine::get_instance().getWindowHeight() - sprite.y);
+	GLfloat bottom = top - static_cast<GLfloat>(sprite.h);
+
+	// The source rect is relative to the image, which may be a region of an atlas page
+	GLfloat u0 = static_cast<GLfloat>(sprite.atlas_x + sprite.src_x) / sprite.texture_w;
+	GLfloat u1 = static_cast<GLfloat>(sprite.atlas_x + sprite.src_x + sprite.src_w) / sprite.texture_w;
+	GLfloat v0 = static_cast<GLfloat>(sprite.atlas_y + sprite.src_y + sprite.src_h) / sprite.texture_h;
+	GLfloat v1 = static_cast<GLfloat>(sprite.atlas_y + sprite.src_y) / sprite.texture_h;
+
+	out[0] = SpriteVertex{ left, top, u0, v0 };
+	out[1] = SpriteVertex{ right, top, u1, v0 };
+	out[2] = SpriteVertex{ right, bottom, u1, v1 };
+	out[3] = SpriteVertex{ left, bottom, u0, v1 };
+}
+
+void SpriteBatch::resetStats() {
+	spriteCount = 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+#include "opengl/glwrappers.hpp"
+
+class Sprite;
+class SpriteMesh;
+
+// The maximum number of sprites that can be queued before the batch is forced to flush
+#define SPRITE_BATCH_MAX_SPRITES	2048
+
+// A single vertex of a batched sprite quad
+struct SpriteVertex {
+	GLfloat x, y;
+	GLfloat u, v;
+};
+
+/*	A streaming sprite batcher
+		- Sprites are written as quads into a CPU side vertex array in screen coordinates
+		- The queued quads are uploaded and drawn with one draw call when the texture
+			changes, the batch is full, or something else needs to be drawn on top
+		- The vertex buffer is orphaned on every flush so the CPU never waits on the GPU
+
+	Usage:
+		- begin() at the start of a frame
+		- submit() for every sprite
+		- flush() before drawing anything that doesn't go through the batch and at the end of the frame
+*/
+class SpriteBatch {
+
+public:
+	SpriteBatch();
+	~SpriteBatch();
+
+	void begin();
+	void submit(const Sprite& sprite);
+	void flush();
+
+	// Draw a prebuilt mesh with the batch shader, flushing anything queued before it
+	void drawMesh(const SpriteMesh& mesh, const Texture& texture);
+
+	// Helper to calculate the screen space quad of a sprite, shared with prebuilt meshes
+	static void writeQuad(const Sprite& sprite, SpriteVertex * out);
+
+	// Number of sprites submitted since the last reset, draw calls are counted in RenderStats
+	inline unsigned int getSpriteCount() const { return spriteCount; }
+	void resetStats();
+
+private:
+	// The shader used to draw every batched sprite
+	Shader shader;
+
+	// OpenGL objects used for streaming the sprite data
+	GLuint VAO, VBO, IBO;
+
+	// CPU side storage of the queued quads
+	std::vector<SpriteVertex> vertices;
+	// The texture all of the currently queued quads are drawn with
+	const Texture * currentTexture;
+
+	// Statistics since the last reset
+	unsigned int spriteCount;
+};
@@ -0,0 +1,100 @@
+#include "spriteMesh.hpp"
+
+#include "engine.hpp"
+#include "sprite.hpp"
+
+SpriteMesh::SpriteMesh() :
+	VAO(0),
+	VBO(0),
+	vertexCount(0)
+{
+
+}
+
+SpriteMesh::~SpriteMesh() {
+	release();
+}
+
+SpriteMesh::SpriteMesh(SpriteMesh && other) :
+	vertices(std::move(other.vertices)),
+	VAO(other.VAO),
+	VBO(other.VBO),
+	vertexCount(other.vertexCount)
+{
+	other.VAO = 0;
+	other.VBO = 0;
+	other.vertexCount = 0;
+}
+
+SpriteMesh & SpriteMesh::operator=(SpriteMesh && other) {
+	if (this != &other) {
+		release();
+		vertices = std::move(other.vertices);
+		VAO = other.VAO;
+		VBO = other.VBO;
+		vertexCount = other.vertexCount;
+		other.VAO = 0;
+		other.VBO = 0;
+		other.vertexCount = 0;
+	}
+	return *this;
+}
+
+void SpriteMesh::clear() {
+	vertices.clear();
+}
+
+void SpriteMesh::addSprite(const Sprite & sprite) {
+	SpriteVertex quad[4];
+	SpriteBatch::writeQuad(sprite, quad);
+	// The mesh isn't indexed, so split the quad into two triangles
+	vertices.push_back(quad[3]);
+	vertices.push_back(quad[1]);
+	vertices.push_back(quad[0]);
+	vertices.push_back(quad[3]);
+	vertices.push_back(quad[2]);
+	vertices.push_back(quad[1]);
+}
+
+void SpriteMesh::upload() {
+	// There is nothing to upload to without an OpenGL context
+	if (Engine::get_instance().isHeadless()) {
+		vertices.clear();
+		return;
+	}
+
+	if (VAO == 0) {
+		glGenVertexArrays(1, &VAO);
+		glGenBuffers(1, &VBO);
+		RenderStats::get_instance().add(RenderStat::BUFFER_CREATIONS, 2);
+
+		glBindVertexArray(VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)0);
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)(2 * sizeof(GLfloat)));
+		glBindVertexArray(0);
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(SpriteVertex) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	vertexCount = static_cast<GLsizei>(vertices.size());
+	// The data lives on the GPU now, no need to keep a copy around
+	vertices.clear();
+	vertices.shrink_to_fit();
+}
+
+void SpriteMesh::bind() const {
+	glBindVertexArray(VAO);
+}
+
+void SpriteMesh::release() {
+	if (VBO) glDeleteBuffers(1, &VBO);
+	if (VAO) glDeleteVertexArrays(1, &VAO);
+	VAO = 0;
+	VBO = 0;
+	vertexCount = 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+#include "spriteBatch.hpp"
+
+class Sprite;
+
+/*	A prebuilt set of sprite quads that lives on the GPU
+		- Useful for static geometry like tilemaps that never change between frames
+		- Quads are added on the CPU and uploaded once, then the whole mesh is drawn with one call
+		- The mesh can be moved but not copied since it owns its OpenGL objects
+*/
+class SpriteMesh {
+
+public:
+	SpriteMesh();
+	~SpriteMesh();
+
+	SpriteMesh(const SpriteMesh&) = delete;
+	SpriteMesh& operator=(const SpriteMesh&) = delete;
+	SpriteMesh(SpriteMesh&& other);
+	SpriteMesh& operator=(SpriteMesh&& other);
+
+	// Functions to build the mesh
+	void clear();
+	void addSprite(const Sprite& sprite);
+	void upload();
+
+	// Functions used by the renderer to draw the mesh
+	void bind() const;
+	inline GLsizei getVertexCount() const { return vertexCount; }
+	inline bool empty() const { return vertexCount == 0; }
+
+private:
+	// CPU side quads waiting to be uploaded
+	std::vector<SpriteVertex> vertices;
+
+	// OpenGL objects holding the uploaded quads
+	GLuint VAO, VBO;
+	GLsizei vertexCount;
+
+	void release();
+};
@@ -1,9 +1,10 @@
 #include "font.hpp"
 
 #include <iostream>
+#include <vector>
 
 Font::Font(const std::string& fontPath, int size):
-    m_textHeight(0) {
+    m_textHeight(0), m_size(size), m_atlasHeight(0), m_atlasTexture(0) {
     if(FT_Init_FreeType(&m_fontLibrary)) {
         std::cerr << "Could not initialize FreeType library" << std::endl;
     }
@@ -20,58 +21,107 @@ Font::~Font() {
     FT_Done_FreeType(m_fontLibrary);
 }
 
-Character Font::generateCharacter(const char character) {
-    // Check if the character has been generated previously
-    auto iter = m_characters.find(character);
-    if(iter != m_characters.end()) {
-        // The character was generated previously
-        return m_characters[character];
-    } else {
-        // Otherwise, let's generate the character.
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
+void Font::rasterize(unsigned char first, unsigned char last) {
+    // Pack the glyphs into rows of the atlas, growing the atlas height when a new row is started
+    int penX = 0;
+    int penY = 0;
+    int rowHeight = 0;
+    m_pixels.clear();
+    m_atlasHeight = 0;
 
-        int asciiCode = int(character);
+    for (int asciiCode = first; asciiCode <= last; ++asciiCode) {
+        char character = static_cast<char>(asciiCode);
 
         // Load the requested character.
         if(FT_Load_Char(m_fontFace, asciiCode, FT_LOAD_RENDER)) {
             std::cerr << "Failed to load character: " << character << std::endl;
             // problems may occur if this happens and it isn't handled
         }
+        const FT_Bitmap& bitmap = m_fontFace->glyph->bitmap;
+        int width = static_cast<int>(bitmap.width);
+        int height = static_cast<int>(bitmap.rows);
+
+        // Move to the next row if the glyph doesn't fit in the current one
+        if (penX + width + FONT_ATLAS_PADDING > FONT_ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + FONT_ATLAS_PADDING;
+            rowHeight = 0;
+        }
+        if (penY + height > m_atlasHeight) {
+            m_atlasHeight = penY + height;
+            m_pixels.resize(FONT_ATLAS_WIDTH * m_atlasHeight, 0);
+        }
 
-        // Generate a texture for the character.
-        GLuint texture;
-        glGenTextures(1, &texture);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        glTexImage2D(
-            GL_TEXTURE_2D, 
-            0, 
-            GL_RED, 
-            m_fontFace->glyph->bitmap.width, 
-            m_fontFace->glyph->bitmap.rows, 
-            0, 
-            GL_RED, 
-            GL_UNSIGNED_BYTE, 
-            m_fontFace->glyph->bitmap.buffer
-        );
-
-        // Configure texture parameters.
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-
-
-        // Store the character.
+        // Copy the glyph bitmap into the atlas
+        for (int row = 0; row < height; ++row) {
+            for (int col = 0; col < width; ++col) {
+                m_pixels[(penY + row) * FONT_ATLAS_WIDTH + penX + col] = bitmap.buffer[row * bitmap.pitch + col];
+            }
+        }
+
+        // Store the character, the texture coordinates are filled in once the atlas size is known
         Character characterObj = {
             character,
-            texture,
-            Vec2<int>(m_fontFace->glyph->bitmap.width, m_fontFace->glyph->bitmap.rows),
+            0,
+            Vec2<int>(width, height),
             Vec2<int>(m_fontFace->glyph->bitmap_left, m_fontFace->glyph->bitmap_top),
-            static_cast<GLuint>(m_fontFace->glyph->advance.x)
+            static_cast<GLuint>(m_fontFace->glyph->advance.x),
+            Vec2<float>(static_cast<float>(penX), static_cast<float>(penY)),
+            Vec2<float>(static_cast<float>(penX + width), static_cast<float>(penY + height))
         };
+        m_characters[character] = characterObj;
 
-        m_characters.insert(std::pair<char, Character>(character, characterObj));
+        penX += width + FONT_ATLAS_PADDING;
+        if (height > rowHeight) rowHeight = height;
+    }
+    // Make sure the texture isn't empty even if no glyphs had any pixels
+    if (m_atlasHeight == 0) {
+        m_atlasHeight = 1;
+        m_pixels.resize(FONT_ATLAS_WIDTH, 0);
+    }
+}
+
+void Font::createAtlasTexture() {
+    // Upload the atlas to a single texture
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Disable byte-alignment restriction
+    glGenTextures(1, &m_atlasTexture);
+    glBindTexture(GL_TEXTURE_2D, m_atlasTexture);
+    glTexImage2D(
+        GL_TEXTURE_2D,
+        0,
+        GL_RED,
+        FONT_ATLAS_WIDTH,
+        m_atlasHeight,
+        0,
+        GL_RED,
+        GL_UNSIGNED_BYTE,
+        m_pixels.data()
+    );
+
+    // Configure texture parameters.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Normalize the glyph texture coordinates now that the final atlas size is known
+    for (auto& pair : m_characters) {
+        Character& ch = pair.second;
+        ch.textureID = m_atlasTexture;
+        ch.uvMin = Vec2<float>(ch.uvMin.x() / FONT_ATLAS_WIDTH, ch.uvMin.y() / m_atlasHeight);
+        ch.uvMax = Vec2<float>(ch.uvMax.x() / FONT_ATLAS_WIDTH, ch.uvMax.y() / m_atlasHeight);
+    }
+    // The pixels aren't needed anymore once they are on the GPU
+    std::vector<unsigned char>().swap(m_pixels);
+}
 
-        return characterObj;
+Character Font::getCharacter(const char character) const {
+    auto iter = m_characters.find(character);
+    if(iter != m_characters.end()) {
+        return iter->second;
     }
+    // The character isn't in the atlas, return an empty glyph
+    Character empty = { character, m_atlasTexture, Vec2<int>(0, 0), Vec2<int>(0, 0), 0, Vec2<float>(0.f, 0.f), Vec2<float>(0.f, 0.f) };
+    return empty;
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H  
@@ -13,7 +14,7 @@
 struct Character {
     // The character represented by this Character
     char character;
-    // ID handle of the glyph texture
+    // ID handle of the atlas texture the glyph is stored in
     GLuint textureID;
     // Size of glyph (width, height)
     Vec2<int> size;
@@ -21,21 +22,48 @@ struct Character {
     Vec2<int> bearing;
     // Offset to advance to next glyph
     GLuint advance;
+    // Texture coordinates of the glyph in the atlas (top left, bottom right)
+    Vec2<float> uvMin;
+    Vec2<float> uvMax;
 };
 
+// Width of the glyph atlas texture, the height grows to fit all the glyphs
+#define FONT_ATLAS_WIDTH    512
+// Empty space between glyphs in the atlas so they don't bleed into each other
+#define FONT_ATLAS_PADDING  1
+// Printable ASCII range, control characters have no glyphs worth rasterizing
+#define FONT_FIRST_CHARACTER    32
+#define FONT_LAST_CHARACTER     126
+
 class Font {
 public:
     // Initializes a new font with the specified size.
     Font(const std::string& fontPath, int size);
     virtual ~Font();
 
-    Character generateCharacter(const char character);
+    // Rasterizes the characters from first to last (inclusive) and packs them into the atlas pixels
+    // Doesn't touch OpenGL, so it can run on any thread
+    void rasterize(unsigned char first, unsigned char last);
+    // Uploads the rasterized atlas to a single texture, has to be called on the OpenGL thread
+    void createAtlasTexture();
+
+    Character getCharacter(const char character) const;
+    inline GLuint getAtlasTexture() const { return m_atlasTexture; }
+    inline int getSize() const { return m_size; }
 private:
     // Used to cache characters
     std::map<char, Character> m_characters;
 
     // Some characters have different heights and this causes problems. This fixes that.
     int m_textHeight;
+    int m_size;
+
+    // Rasterized glyphs waiting for the upload
+    std::vector<unsigned char> m_pixels;
+    int m_atlasHeight;
+
+    // The atlas texture holding every generated glyph, ownership is passed to whoever uses it
+    GLuint m_atlasTexture;
 
     // Used to generate characters
     FT_Library m_fontLibrary;
@@ -1,39 +1,82 @@
 #include "textRenderer.hpp"
 #include <algorithm>
+#include <iterator>
 
-TextRenderer::TextRenderer(const std::string& fontPath, int size, Vec2<int> windowSize) :
-    m_shader("res/shaders/text_vertex.glsl", "res/shaders/text_fragment.glsl"), m_fontSize(size), m_windowSize(windowSize){
-    Font font(fontPath, size);
+#include "../profiler.hpp"
+#include "../opengl/renderStats.hpp"
+
+// Initial number of glyph quads the vertex buffer has room for
+#define TEXT_INITIAL_GLYPH_CAPACITY 256
+
+TextRenderer::TextRenderer(Font& font, Vec2<int> windowSize) :
+    m_shader("res/shaders/text_vertex.glsl", "res/shaders/text_fragment.glsl"), m_fontSize(font.getSize()), m_windowSize(windowSize),
+    m_atlas(0), m_bufferCapacity(TEXT_INITIAL_GLYPH_CAPACITY * 6) {
+	font.createAtlasTexture();
+	m_atlas = font.getAtlasTexture();
 
 	m_text.resize(128);
-	for (char c = 0; c < 127; ++c) {
-		m_text[c] = font.generateCharacter(c);
+	for (int c = 0; c < 128; ++c) {
+		m_text[c] = font.getCharacter(static_cast<char>(c));
 	}
+	m_vertices.reserve(m_bufferCapacity);
 
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
+    RenderStats::get_instance().add(RenderStat::BUFFER_CREATIONS, 2);
     glBindVertexArray(VAO);
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(TextVertex) * m_bufferCapacity, NULL, GL_STREAM_DRAW);
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), 0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(TextVertex), 0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (void*)(4 * sizeof(GLfloat)));
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 }
 
-void TextRenderer::render(std::string s, ScreenCoord pos, float scale) {
+TextRenderer::~TextRenderer() {
+	glDeleteBuffers(1, &VBO);
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteTextures(1, &m_atlas);
+}
+
+void TextRenderer::render(const std::string& s, ScreenCoord pos, float scale) {
 	renderLine(s, pos, scale, m_colour, m_ha, m_va);
 }
 
-void TextRenderer::renderLine(std::string s, ScreenCoord pos, float scale, Colour colour, TextRenderer::hAlign ha, TextRenderer::vAlign va) {
+void TextRenderer::flush() {
+	if (m_vertices.empty()) return;
+
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     m_shader.bind();
-    m_shader.setUniform3f("textColour", colour.r(), colour.g(), colour.b());
     glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_atlas);
+    RenderStats::get_instance().add(RenderStat::TEXTURE_BINDS);
     glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+	// Grow the buffer if more text was queued than fits, otherwise orphan the old storage so the driver doesn't stall
+	if (m_vertices.size() > m_bufferCapacity) {
+		m_bufferCapacity = m_vertices.capacity();
+	}
+    glBufferData(GL_ARRAY_BUFFER, sizeof(TextVertex) * m_bufferCapacity, NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(TextVertex) * m_vertices.size(), m_vertices.data());
+    glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertices.size()));
+    RenderStats::get_instance().add(RenderStat::DRAW_CALLS);
+    RenderStats::get_instance().add(RenderStat::VERTICES, static_cast<unsigned int>(m_vertices.size()));
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    m_shader.unbind();
+
+	m_vertices.clear();
+}
 
+void TextRenderer::renderLine(const std::string& s, ScreenCoord pos, float scale, Colour colour, TextRenderer::hAlign ha, TextRenderer::vAlign va) {
+	PROFILE_SCOPE("TextRenderer::renderLine");
 	Vec2<float> sSize = computeLineSize(s, scale);
 	GLfloat x_begin;
 	switch (ha) {
@@ -65,46 +108,48 @@ void TextRenderer::renderLine(std::string s, ScreenCoord pos, float scale, Colou
 	GLfloat y = -static_cast<GLfloat>(y_begin);	// Sign error somewhere below perhaps.
 	
 
+	GLfloat r = static_cast<GLfloat>(colour.r());
+	GLfloat g = static_cast<GLfloat>(colour.g());
+	GLfloat b = static_cast<GLfloat>(colour.b());
+
     for(char c : s) {
+		// Only the ascii characters are in the atlas
+		if (static_cast<unsigned char>(c) >= m_text.size()) continue;
 		Character ch = m_text[c];
         GLfloat xpos = static_cast<GLfloat>(x + ch.bearing.x()*scale);
         GLfloat ypos = static_cast<GLfloat>(y + ch.bearing.y()*scale);
 
         GLfloat w = static_cast<GLfloat>(ch.size.x()) * scale;
         GLfloat h = static_cast<GLfloat>(ch.size.y()) * scale;
+
+		GLfloat u0 = ch.uvMin.x();
+		GLfloat v0 = ch.uvMin.y();
+		GLfloat u1 = ch.uvMax.x();
+		GLfloat v1 = ch.uvMax.y();
 			
 		int winHeight = m_windowSize.y();
-        // Update VBO for each character
-        GLfloat vertices[] = {
+        // Queue the quad for each character
+        TextVertex vertices[] = {
 			// (winHeight - h) makes the text start from the top left corner 
-             xpos,     ypos + h + (winHeight - h),   0.0, 0.0 ,
-             xpos,     ypos + (winHeight - h),       0.0, 1.0 ,
-             xpos + w, ypos + (winHeight - h),       1.0, 1.0 ,
+             { xpos,     ypos + h + (winHeight - h),   u0, v0, r, g, b },
+             { xpos,     ypos + (winHeight - h),       u0, v1, r, g, b },
+             { xpos + w, ypos + (winHeight - h),       u1, v1, r, g, b },
 
-             xpos,     ypos + h + (winHeight - h),   0.0, 0.0 ,
-             xpos + w, ypos + (winHeight - h),       1.0, 1.0 ,
-             xpos + w, ypos + h + (winHeight - h),   1.0, 0.0
+             { xpos,     ypos + h + (winHeight - h),   u0, v0, r, g, b },
+             { xpos + w, ypos + (winHeight - h),       u1, v1, r, g, b },
+             { xpos + w, ypos + h + (winHeight - h),   u1, v0, r, g, b }
         };
+		m_vertices.insert(m_vertices.end(), std::begin(vertices), std::end(vertices));
 
-        // Render glyph texture over quad
-        glBindTexture(GL_TEXTURE_2D, ch.textureID);
-        // Update content of VBO memory
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices); 
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        // Render quad
-        glDrawArrays(GL_TRIANGLES, 0, 6);
         // Now advance cursors for next glyph (note that advance is number of 1/64 pixels)
         x += (ch.advance >> 6)*scale; // Bitshift by 6 to get value in pixels (2^6 = 64)
     }
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    m_shader.unbind();
 }
 
-Vec2<float> TextRenderer::computeLineSize(std::string s, float scale) {
+Vec2<float> TextRenderer::computeLineSize(const std::string& s, float scale) {
 	int x = 0;
 	for (char c : s) {
+		if (static_cast<unsigned char>(c) >= m_text.size()) continue;
 		Character ch = m_text[c];
 		x += (ch.advance >> 6);	// Bitshift by 6 to get value in pixels (2^6 = 64)
 	}
@@ -8,6 +8,13 @@
 #include "font.hpp"
 #include "../opengl/glwrappers.hpp"
 
+// A single vertex of a queued glyph quad
+struct TextVertex {
+	GLfloat x, y;
+	GLfloat u, v;
+	GLfloat r, g, b;
+};
+
 /**
  * Basic usage of Text (OUTDATED. See Core implementation)
  * 
@@ -33,30 +40,56 @@
  * 150 pixels from the left side of the window and at the top of the window.
  **/
 
-class TextRenderer {
+// Interface of the text rendering backend, so the engine can run without a GPU
+class BaseTextRenderer {
 public:
 
 	enum hAlign { left, centre, right };
 	enum vAlign { top, middle, bottom };
 
-    TextRenderer(const std::string& fontPath, int size, Vec2<int> windowSize);
+	virtual ~BaseTextRenderer() {}
 
-	void render(std::string s, ScreenCoord pos, float scale = 1.f);
+	virtual void render(const std::string& s, ScreenCoord pos, float scale = 1.f) = 0;
+	virtual void flush() = 0;
 	inline void setAlignment(hAlign ha, vAlign va) { m_ha = ha; m_va = va; }
 	inline void setColour(Colour colour) { m_colour = colour; }
 
-private:
+protected:
+
+	hAlign m_ha = hAlign::left;
+	vAlign m_va = vAlign::top;
+	Colour m_colour = Colour(0,0,0);
+};
+
+/*	Text is drawn from a single glyph atlas texture
+		- render() only queues the glyph quads of the string along with their colour
+		- Every queued string is drawn at once with one draw call when flush() is called
+		- flush() has to be called before anything else is drawn on top of the text and at the end of the frame
+*/
+class TextRenderer : public BaseTextRenderer {
+public:
+
+    // The font has to be rasterized already, its atlas is uploaded here
+    TextRenderer(Font& font, Vec2<int> windowSize);
+	~TextRenderer();
 
-	void renderLine(std::string s, ScreenCoord pos, float scale, Colour colour = Colour(0, 0, 0), hAlign ha = hAlign::left, vAlign va = vAlign::top);
+	void render(const std::string& s, ScreenCoord pos, float scale = 1.f) override;
+	void flush() override;
+
+private:
+	void renderLine(const std::string& s, ScreenCoord pos, float scale, Colour colour = Colour(0, 0, 0), hAlign ha = hAlign::left, vAlign va = vAlign::top);
     std::vector<Character> m_text;
-	Vec2<float> computeLineSize(std::string s, float scale);
+	Vec2<float> computeLineSize(const std::string& s, float scale);
 
 	int m_fontSize;
 	Vec2<int> m_windowSize;
     Shader m_shader;
     GLuint VAO, VBO;
 
-	hAlign m_ha = hAlign::left;
-	vAlign m_va = vAlign::top;
-	Colour m_colour = Colour(0,0,0);
+	// The texture every glyph is packed into
+	GLuint m_atlas;
+	// Glyph quads waiting to be drawn
+	std::vector<TextVertex> m_vertices;
+	// Size of the vertex buffer storage in vertices, it grows when more text is queued
+	size_t m_bufferCapacity;
 };
\ No newline at end of file
@@ -1,23 +1,249 @@
 #include "textureManager.hpp"
 
+#include <SDL2/SDL.h>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image/stb_image.h>
+
+#include "assetArchive.hpp"
+
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
 #include "opengl/texture.hpp"
 
-TextureManager::TextureManager() {
+#ifdef _DEBUG
+#define LOG(x) std::cout << x << std::endl
+#else
+#define LOG(x)
+#endif
+
+TextureManager::TextureManager(bool headless) :
+	m_headless(headless),
+	m_placeholder(nullptr),
+	m_pending(0),
+	m_frame(0),
+	m_budget(TEXTURE_MEMORY_BUDGET),
+	m_residentBytes(0),
+	m_stopping(false)
+{
+	// A headless manager creates its textures right away since they only read the file header
+	if (m_headless) return;
+
+	// Drawn in place of textures that haven't been uploaded yet
+	const unsigned char placeholder[4] = { 0, 0, 0, 0 };
+	m_placeholder = new Texture(1, 1, placeholder);
 
+	// Set once here since the flag is shared by every thread using stb_image
+	stbi_set_flip_vertically_on_load(1);
+	for (int i = 0; i < TEXTURE_DECODE_THREADS; ++i) {
+		m_workers.emplace_back(&TextureManager::decodeWorker, this);
+	}
 }
 
 TextureManager::~TextureManager() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_condition.notify_all();
+	for (std::thread& worker : m_workers) {
+		worker.join();
+	}
+	for (DecodedImage& image : m_decoded) {
+		if (image.owned) stbi_image_free(image.pixels);
+	}
 
+	for (TextureSlot& slot : m_slots) {
+		delete slot.texture;
+	}
+	delete m_placeholder;
 }
 
-Texture * TextureManager::getTexture(const std::string & fileName) {
-	if (m_textures.find(fileName) == m_textures.end()) {
-		m_textures[fileName] = new Texture(fileName);
+TextureHandle TextureManager::getHandle(const std::string & fileName) {
+	auto it = m_handles.find(fileName);
+	if (it != m_handles.end()) return it->second;
+
+	TextureHandle handle = static_cast<TextureHandle>(m_slots.size());
+	TextureSlot slot = { fileName, nullptr, 0, 0, SlotState::UNLOADED, 0, 0, 0 };
+	// Only the header is read here so the size is known before the pixels are decoded
+	int channels;
+	const AssetView * asset = AssetArchive::get_instance().find(fileName);
+	if (asset && asset->type == AssetType::TEXTURE) {
+		slot.width = asset->width;
+		slot.height = asset->height;
 	}
-	return m_textures[fileName];
+	else if (!stbi_info(fileName.c_str(), &slot.width, &slot.height, &channels)) {
+		std::cerr << "Could not read texture: " << fileName << std::endl;
+	}
+	m_slots.push_back(slot);
+	m_handles.emplace(fileName, handle);
+	return handle;
+}
+
+Texture * TextureManager::getTexture(const std::string & fileName) {
+	return getTexture(getHandle(fileName));
 }
 
 void TextureManager::deleteTexture(const std::string & fileName) {
-	delete m_textures[fileName];
-	m_textures.erase(fileName);
-}
\ No newline at end of file
+	auto it = m_handles.find(fileName);
+	if (it == m_handles.end()) return;
+	unload(m_slots[it->second]);
+}
+
+void TextureManager::unload(TextureSlot & slot) {
+	if (slot.texture && !m_headless) m_residentBytes -= static_cast<size_t>(slot.width) * slot.height * 4;
+	delete slot.texture;
+	slot.texture = nullptr;
+	// A decode that is still running belongs to the deleted texture, the next request starts a new one
+	if (slot.state == SlotState::DECODING) slot.generation++;
+	if (slot.state == SlotState::READY || slot.state == SlotState::DECODING) slot.state = SlotState::UNLOADED;
+}
+
+void TextureManager::request(TextureHandle handle) {
+	TextureSlot& slot = m_slots[handle];
+	if (slot.state != SlotState::UNLOADED) return;
+
+	if (m_headless) {
+		slot.texture = new Texture(slot.width, slot.height);
+		slot.state = SlotState::READY;
+		return;
+	}
+
+	slot.state = SlotState::DECODING;
+	m_pending++;
+	// Packed textures skip the decoding threads and go straight to the upload queue
+	const AssetView * asset = AssetArchive::get_instance().find(slot.path);
+	if (asset && asset->type == AssetType::TEXTURE) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_decoded.push_back(DecodedImage{ handle, slot.generation, const_cast<unsigned char*>(asset->data), asset->width, asset->height, false });
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_jobs.push_back(DecodeJob{ handle, slot.generation, slot.path });
+	}
+	m_condition.notify_one();
+}
+
+void TextureManager::prefetch(const std::vector<std::string>& fileNames) {
+	for (const std::string& fileName : fileNames) {
+		// Packed images are loaded as part of their atlas page
+		const AtlasRegion * region = getRegion(fileName);
+		request(getHandle(region ? region->page : fileName));
+	}
+}
+
+void TextureManager::update() {
+	m_frame++;
+	if (m_headless) return;
+	if (m_residentBytes > m_budget) evict();
+	if (m_pending == 0) return;
+
+	Uint64 start = SDL_GetPerformanceCounter();
+	double budget = TEXTURE_UPLOAD_BUDGET * static_cast<double>(SDL_GetPerformanceFrequency()) / 1000.0;
+	do {
+		DecodedImage image;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_decoded.empty()) return;
+			image = m_decoded.front();
+			m_decoded.pop_front();
+		}
+		m_pending--;
+
+		TextureSlot& slot = m_slots[image.handle];
+		// The texture was deleted while it was decoding
+		if (image.generation != slot.generation) {
+			if (image.owned) stbi_image_free(image.pixels);
+			continue;
+		}
+		if (!image.pixels) {
+			std::cerr << "Could not decode texture: " << slot.path << std::endl;
+			slot.state = SlotState::FAILED;
+			continue;
+		}
+		slot.texture = new Texture(image.width, image.height, image.pixels);
+		slot.state = SlotState::READY;
+		m_residentBytes += static_cast<size_t>(image.width) * image.height * 4;
+		if (image.owned) stbi_image_free(image.pixels);
+	} while (static_cast<double>(SDL_GetPerformanceCounter() - start) < budget);
+}
+
+void TextureManager::evict() {
+	std::vector<TextureHandle> candidates;
+	for (TextureHandle handle = 0; handle < m_slots.size(); ++handle) {
+		const TextureSlot& slot = m_slots[handle];
+		// Eviction runs before anything is drawn, so anything drawn in the previous frame is still in use
+		// even without a sprite holding on to it
+		if (slot.texture && slot.refCount <= 0 && slot.lastUsed + 1 < m_frame) candidates.push_back(handle);
+	}
+	std::sort(candidates.begin(), candidates.end(), [this](TextureHandle a, TextureHandle b) {
+		return m_slots[a].lastUsed < m_slots[b].lastUsed;
+	});
+	for (TextureHandle handle : candidates) {
+		if (m_residentBytes <= m_budget) break;
+		unload(m_slots[handle]);
+	}
+}
+
+std::vector<std::pair<std::string, size_t>> TextureManager::getMemoryReport() const {
+	std::map<std::string, size_t> directories;
+	for (const TextureSlot& slot : m_slots) {
+		if (!slot.texture || m_headless) continue;
+		size_t separator = slot.path.find_last_of('/');
+		std::string directory = separator == std::string::npos ? "" : slot.path.substr(0, separator);
+		directories[directory] += static_cast<size_t>(slot.width) * slot.height * 4;
+	}
+	return std::vector<std::pair<std::string, size_t>>(directories.begin(), directories.end());
+}
+
+void TextureManager::decodeWorker() {
+	while (true) {
+		DecodeJob job;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+			if (m_stopping) return;
+			job = m_jobs.front();
+			m_jobs.pop_front();
+		}
+
+		DecodedImage image = { job.handle, job.generation, nullptr, 0, 0, true };
+		int channels;
+		image.pixels = stbi_load(job.path.c_str(), &image.width, &image.height, &channels, 4);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_decoded.push_back(image);
+	}
+}
+
+bool TextureManager::loadAtlas(const std::string & fileName) {
+	json data;
+	if (!AssetArchive::get_instance().loadJson(fileName, data)) return false;
+
+	std::vector<std::string> pages = data["pages"];
+	for (const auto& region : data["regions"].items()) {
+		const json& value = region.value();
+		int page = value["page"];
+		m_regions[region.key()] = AtlasRegion{ pages[page], value["x"], value["y"], value["w"], value["h"] };
+	}
+	LOG("Loaded " << m_regions.size() << " atlas regions on " << pages.size() << " pages");
+	return true;
+}
+
+const AtlasRegion * TextureManager::getRegion(const std::string & fileName) const {
+	auto it = m_regions.find(fileName);
+	if (it == m_regions.end()) return nullptr;
+	return &it->second;
+}
+
+Vec2<int> TextureManager::getImageSize(const std::string & fileName) {
+	const AtlasRegion * region = getRegion(fileName);
+	if (region) return Vec2<int>(region->w, region->h);
+	return getImageSize(getHandle(fileName));
+}
@@ -1,19 +1,153 @@
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
+
+#include "../math/vec.hpp"
 
 class Texture;
 
+// Index of a texture slot in the texture manager, stays valid for the lifetime of the manager
+typedef unsigned int TextureHandle;
+#define INVALID_TEXTURE_HANDLE	0xFFFFFFFF
+
+// Number of worker threads decoding images in the background
+#define TEXTURE_DECODE_THREADS	2
+// Time spent uploading decoded images to the GPU per frame, at least one image is uploaded every frame
+#define TEXTURE_UPLOAD_BUDGET	2.0	// ms
+// Default amount of texture memory to keep resident before unused textures get evicted
+#define TEXTURE_MEMORY_BUDGET	(256 * 1024 * 1024)	// bytes
+
+// Lookup table written by tools/atlasPacker, loaded on startup if it exists
+#define ATLAS_FILE	"res/atlas/atlas.json"
+
+// Where a packed image ended up inside an atlas page
+struct AtlasRegion {
+	std::string page;
+	// Position of the image in the page, measured from the top left like the original image
+	int x, y;
+	int w, h;
+};
+
+/*	Owns every texture used by sprites
+		- Paths are resolved to handles once, using a handle is an array index
+		- The image size is read from the file header right away, but the pixels are decoded
+			on worker threads and uploaded on the main thread within a per frame budget
+		- Until a texture is uploaded, a transparent placeholder texture is returned instead
+		- prefetch() starts decoding textures before they are used
+		- Sprites hold a reference to their texture, once the resident textures go over the
+			memory budget the least recently used textures without references are evicted
+			and get loaded again the next time they are used
+*/
 class TextureManager {
 public:
 
-	TextureManager();
+	// A headless texture manager only loads image sizes without creating any OpenGL textures
+	TextureManager(bool headless = false);
 	~TextureManager();
 
+	// Resolve a path once and keep the handle, looking up a texture by handle is just an array index
+	TextureHandle getHandle(const std::string& fileName);
+	inline Texture* getTexture(TextureHandle handle) {
+		TextureSlot& slot = m_slots[handle];
+		slot.lastUsed = m_frame;
+		if (slot.texture) return slot.texture;
+		request(handle);
+		return slot.texture ? slot.texture : m_placeholder;
+	}
 	Texture* getTexture(const std::string& fileName);
+	// Deleted textures are loaded again the next time their handle is used
 	void deleteTexture(const std::string& fileName);
 
+	// Textures with references are never evicted
+	inline void addRef(TextureHandle handle) { m_slots[handle].refCount++; }
+	inline void release(TextureHandle handle) { m_slots[handle].refCount--; }
+
+	// Load the atlas lookup table, images that aren't in it keep being loaded as loose textures
+	bool loadAtlas(const std::string& fileName);
+	// The atlas region of an image or nullptr if it isn't packed
+	const AtlasRegion* getRegion(const std::string& fileName) const;
+	// Size of an image, without loading it separately if it is packed
+	Vec2<int> getImageSize(const std::string& fileName);
+	inline Vec2<int> getImageSize(TextureHandle handle) const { return Vec2<int>(m_slots[handle].width, m_slots[handle].height); }
+
+	// Start decoding textures in the background so they are ready when they are first drawn
+	void prefetch(const std::vector<std::string>& fileNames);
+	// Upload decoded textures until the frame budget runs out, has to be called on the OpenGL thread
+	void update();
+	// Number of textures that are still being decoded or waiting for an upload
+	inline unsigned int getPendingCount() const { return m_pending; }
+
+	inline void setMemoryBudget(size_t bytes) { m_budget = bytes; }
+	inline size_t getMemoryBudget() const { return m_budget; }
+	inline size_t getResidentBytes() const { return m_residentBytes; }
+	// Resident texture bytes grouped by the directory of the image, sorted by directory
+	std::vector<std::pair<std::string, size_t>> getMemoryReport() const;
+
 private:
-	std::unordered_map<std::string, Texture*> m_textures;
-};
\ No newline at end of file
+	enum class SlotState {
+		UNLOADED,
+		DECODING,
+		READY,
+		FAILED
+	};
+
+	struct TextureSlot {
+		std::string path;
+		Texture * texture;
+		int width, height;
+		SlotState state;
+		// Number of sprites using the texture and the frame it was last drawn in
+		int refCount;
+		unsigned int lastUsed;
+		// Bumped when the texture is deleted while decoding, so the outdated decode is thrown away
+		unsigned int generation;
+	};
+
+	// Work passed between the main thread and the decoding threads
+	struct DecodeJob {
+		TextureHandle handle;
+		unsigned int generation;
+		std::string path;
+	};
+	struct DecodedImage {
+		TextureHandle handle;
+		unsigned int generation;
+		unsigned char * pixels;
+		int width, height;
+		// Decoded pixels are freed after the upload, packed ones belong to the archive
+		bool owned;
+	};
+
+	std::vector<TextureSlot> m_slots;
+	std::unordered_map<std::string, TextureHandle> m_handles;
+	std::unordered_map<std::string, AtlasRegion> m_regions;
+	bool m_headless;
+	Texture * m_placeholder;
+	unsigned int m_pending;
+
+	// Memory bookkeeping for eviction
+	unsigned int m_frame;
+	size_t m_budget;
+	size_t m_residentBytes;
+
+	// Decoding threads and the queues they share with the main thread
+	std::vector<std::thread> m_workers;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<DecodeJob> m_jobs;
+	std::deque<DecodedImage> m_decoded;
+	bool m_stopping;
+
+	// Queue the texture for decoding if it isn't loaded or loading already
+	void request(TextureHandle handle);
+	void decodeWorker();
+	// Free the least recently used textures without references until the budget is met
+	void evict();
+	void unload(TextureSlot& slot);
+};
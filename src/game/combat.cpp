@@ -19,6 +19,7 @@
 
 #include <utility>
 #include <fstream>
+#include <iostream>
 using json = nlohmann::json;
 
 Combat::Combat(const std::string & filePath, bool last_level) :
@@ -27,15 +28,14 @@ Combat::Combat(const std::string & filePath, bool last_level) :
 	pauseBase("res/assets/UI/pauseBase.png"),
 	cursor("res/assets/UI/cursor.png"),
 	cursorPress("res/assets/UI/cursorPress.png"),
-	last_level(last_level)
+	last_level(last_level),
+	occupancy_version(0)
 {
 	initSprites();
 
 	// Load grid and enemy data from the file path
-	std::ifstream file(filePath);
-	if (file.is_open()) {
-		json data;
-		file >> data;
+	json data;
+	if (Core::loadJson(filePath, data)) {
 
 		std::string grid_path = data["map"];
 		grid = Grid(std::string("res/data/maps/") + grid_path);
@@ -107,6 +107,7 @@ Combat::Combat(const std::string & filePath, bool last_level) :
 		}
 	}
 	for (Unit * unit : units) unit->combat = this;
+	rebuildOccupancy();
 
 	// Initialize the particle system
 	ps = ParticleSystem();
@@ -218,10 +219,10 @@ void Combat::update(int delta) {
 		grid.update();
 		ps.update();
 		for (Entity * e : entities) e->update(delta);
+		if (Core::getDebugMode()) checkOccupancy();
 
 		if (current->getType() == UnitType::PLAYER && current->getState() == UnitState::IDLE) {
-			Player * player = dynamic_cast<Player*>(current);
-			player->setPathLine(grid.getMouseToGrid());
+			updateHoverPath(dynamic_cast<Player*>(current));
 		}
 
 		// If the game isn't over, keep going with the turn order
@@ -326,6 +327,13 @@ void Combat::render() {
 		Core::Text_Renderer::render("QUIT", quitButton.position + Vec2<int>(120, 32), 1.8f);
 	}
 
+	if (Core::getDebugMode()) {
+		unsigned int total = hoverPath.hits + hoverPath.misses;
+		int hit_rate = total > 0 ? static_cast<int>(100 * hoverPath.hits / total) : 0;
+		Core::addDebugText("HOVER PATH HITS: " + std::to_string(hoverPath.hits) + " MISSES: " +
+			std::to_string(hoverPath.misses) + " (" + std::to_string(hit_rate) + "%)");
+	}
+
 	// Render the cursor
 	if (mouseDown) {
 		cursorPress.setPos(mouseX, mouseY);
@@ -339,12 +347,9 @@ void Combat::render() {
 // Returns the unit occupying the specified grid coordinate
 Unit * Combat::getUnitAt(ScreenCoord at)
 {
-	for (Unit * unit : units) {
-		if (unit->position.x() == at.x() && unit->position.y() == at.y()) {
-			return unit;
-		}
-	}
-	return nullptr;
+	int index = getOccupancyIndex(at);
+	if (index < 0) return nullptr;
+	return occupancy[index];
 }
 
 std::vector<Player*> Combat::getPlayers() const {
@@ -376,12 +381,12 @@ void Combat::addEnemy(Enemy * enemy, int x, int y) {
 
 void Combat::initSprites() {
 	// Calculate game over menu sprite position
-	int width = gameOverBase.getTexture().getWidth();
-	int height = gameOverBase.getTexture().getHeight();
+	int width = gameOverBase.original_w;
+	int height = gameOverBase.original_h;
 	gameOverBase.setPos((Core::windowWidth() - width) / 2, (Core::windowHeight() - height) / 2);
 	// Calculate pause menu sprite position
-	width = pauseBase.getTexture().getWidth();
-	height = pauseBase.getTexture().getHeight();
+	width = pauseBase.original_w;
+	height = pauseBase.original_h;
 	pauseBase.setPos((Core::windowWidth() - width) / 2, (Core::windowHeight() - height) / 2);
 
 	continueButton = ButtonData(ScreenCoord(SubDiv::hCenter() - 120, SubDiv::vPos(40, 27)));
@@ -526,14 +531,69 @@ void Combat::updateWinStatus() {
 
 bool Combat::isPosEmpty(Vec2<int> pos) const {
 	if (!grid.isPosValid(pos)) return false;
-	for (const Unit * unit : units) {
-		if (unit->position == pos) {
-			return false;
+	return occupancy[getOccupancyIndex(pos)] == nullptr;
+}
+
+void Combat::updateOccupancy(Unit * unit, Vec2<int> from, Vec2<int> to) {
+	if (from == to) return;
+	occupancy_version++;
+	int from_index = getOccupancyIndex(from);
+	if (from_index >= 0 && occupancy[from_index] == unit) occupancy[from_index] = nullptr;
+	int to_index = getOccupancyIndex(to);
+	if (to_index >= 0) occupancy[to_index] = unit;
+}
+
+bool Combat::checkOccupancy() const {
+	bool valid = true;
+	// Every unit should be stored at its own position
+	for (Unit * unit : units) {
+		int index = getOccupancyIndex(unit->position);
+		if (index >= 0 && occupancy[index] != unit) {
+			std::cerr << "ERROR: occupancy index doesn't match unit at (" << unit->position.x() << ", " << unit->position.y() << ")\n";
+			valid = false;
 		}
 	}
-	return true;
+	// Every occupied tile should hold a unit that is actually standing there
+	for (unsigned int i = 0; i < occupancy.size(); ++i) {
+		if (!occupancy[i]) continue;
+		const Vec2<int>& pos = occupancy[i]->position;
+		if (getOccupancyIndex(pos) != static_cast<int>(i)) {
+			std::cerr << "ERROR: stale occupancy entry at tile " << i << "\n";
+			valid = false;
+		}
+	}
+	return valid;
+}
+
+void Combat::rebuildOccupancy() {
+	occupancy_version++;
+	occupancy.assign(grid.map_width * grid.map_height, nullptr);
+	for (Unit * unit : units) {
+		int index = getOccupancyIndex(unit->position);
+		if (index >= 0) occupancy[index] = unit;
+	}
+}
+
+int Combat::getOccupancyIndex(Vec2<int> pos) const {
+	if (pos.x() < 0 || pos.x() >= grid.map_width) return -1;
+	if (pos.y() < 0 || pos.y() >= grid.map_height) return -1;
+	return pos.y() * grid.map_width + pos.x();
+}
+
+void Combat::updateHoverPath(Player * player) {
+	ScreenCoord target = grid.getMouseToGrid();
+	if (hoverPath.unit == player && hoverPath.source == player->position && hoverPath.target == target && hoverPath.occupancy_version == occupancy_version) {
+		hoverPath.hits++;
+		return;
+	}
+	hoverPath.misses++;
+	hoverPath.unit = player;
+	hoverPath.source = player->position;
+	hoverPath.target = target;
+	hoverPath.occupancy_version = occupancy_version;
+	player->setPathLine(target);
 }
 
-void Combat::addEmitter(Emitter * emitter) {
-	ps.addEmitter(emitter);
+void Combat::addEmitter(const Emitter& emitter, ScreenCoord position, int angle) {
+	ps.addEmitter(emitter, position, angle);
 }
@@ -4,6 +4,7 @@
 #include "../math/vec.hpp"
 
 #include "combat/grid.hpp"
+#include "combat/pathfinder.hpp"
 #include "../engine/particleSystem.hpp"
 #include "util/button.hpp"
 #include "unitData.hpp"
@@ -28,6 +29,17 @@ class Unit;
 class Player;
 class Enemy;
 
+// The key of the last hover path that was computed, the path only changes if one of these does
+struct HoverPathCache {
+	Unit * unit = nullptr;
+	ScreenCoord source;
+	ScreenCoord target;
+	unsigned int occupancy_version = 0;
+	// Statistics to show how often the path is reused
+	unsigned int hits = 0;
+	unsigned int misses = 0;
+};
+
 // TODO: Implement loading unit stats and calculating health, speed, etc. accordingly
 // TODO: Somehow merge the selectUnit and nextUnitTurn functions
 class Combat : public State {
@@ -53,9 +65,19 @@ public:
 	Grid grid;
 	bool isPosEmpty(Vec2<int> pos) const;
 
+	// Units have to call this whenever their grid position changes to keep the occupancy index correct
+	void updateOccupancy(Unit * unit, Vec2<int> from, Vec2<int> to);
+	// Debugging function to verify the occupancy index against the unit list
+	bool checkOccupancy() const;
+	// Incremented whenever a unit changes tiles, used to tell when cached searches are out of date
+	inline unsigned int getOccupancyVersion() const { return occupancy_version; }
+
+	// Shared pathfinder so the search buffers are reused between units
+	Pathfinder pathfinder;
+
 	// Particle System
 	ParticleSystem ps;
-	void addEmitter(Emitter * emitter);
+	void addEmitter(const Emitter& emitter, ScreenCoord position, int angle);
 
 private:
 
@@ -92,6 +114,13 @@ private:
 	// Store a reference to all the units in the combat state
 	std::vector<Unit*> units;
 
+	// The unit standing on each tile of the grid, indexed the same way as the grid tilemap
+	// Dead units stay in the index since their bodies still block the tile
+	std::vector<Unit*> occupancy;
+	unsigned int occupancy_version;
+	void rebuildOccupancy();
+	int getOccupancyIndex(Vec2<int> pos) const;
+
 	// Utility functions for turn ordering
 	void nextUnitTurn();
 	void selectUnit(Unit * unit);
@@ -107,5 +136,9 @@ private:
 	// Other helper functions
 	void updateWinStatus();
 
+	// Only recompute the path to the mouse when the mouse tile or the board changes
+	HoverPathCache hoverPath;
+	void updateHoverPath(Player * player);
+
 
 };
\ No newline at end of file
@@ -3,7 +3,6 @@
 #include "../combat.hpp"
 #include "unit.hpp"
 #include "status.hpp"
-#include "../util/particleloader.hpp"
 
 // Construct an invalid attack by default
 Attack::Attack() :
@@ -90,6 +89,8 @@ void Attack::attack(ScreenCoord pos, Combat& combat) {
 	}
 	// Apply the particles
 	for (ParticleData& particle : particles) {
+		const Emitter * emitter = Particles::getTemplate(particle.id);
+		if (!emitter) continue;
 		if (particle.position == ParticlePosition::TARGET) {
 			// Set the target to the center of the target
 			int x = pos.x() * combat.grid.tile_width + combat.grid.tile_width / 2;
@@ -99,14 +100,13 @@ void Attack::attack(ScreenCoord pos, Combat& combat) {
 			if (pos.y() > source->position.y()) angle = 180;
 			if (pos.x() < source->position.x()) angle = 270;
 			if (pos.x() > source->position.x()) angle = 90;
-			combat.addEmitter(Particles::get(particle.name, angle, x, y));
+			combat.addEmitter(*emitter, ScreenCoord(x, y), angle);
 		}
 		if (particle.position == ParticlePosition::SELF) {
-			combat.addEmitter(Particles::get(
-				particle.name,
-				source->screenPosition.x() + source->getSpriteWidth() / 2,
-				source->screenPosition.y() + source->getSpriteHeight() - source->getTileHeight())
-			);
+			combat.addEmitter(*emitter,
+				ScreenCoord(source->screenPosition.x() + source->getSpriteWidth() / 2,
+					source->screenPosition.y() + source->getSpriteHeight() - source->getTileHeight()),
+				emitter->angle);
 		}
 	}
 }
@@ -119,8 +119,8 @@ void Attack::addEffectModifier(Stat stat, float multiplier) {
 	effectModifiers.emplace_back(stat, multiplier);
 }
 
-void Attack::addParticle(std::string name, ParticlePosition pos) {
-	particles.push_back(ParticleData{ name, pos });
+void Attack::addParticle(ParticleId id, ParticlePosition pos) {
+	particles.push_back(ParticleData{ id, pos });
 }
 
 // Display the valid attack tiles on the grid
@@ -323,7 +323,7 @@ void BlinkEffect::attack(ScreenCoord pos, Combat & combat, const Attack & attack
 	if (combat.isPosEmpty(pos)) {
 		// This is really bad, do not do this in the future
 		Unit * unit = const_cast<Unit*>(attack.getSource());
-		unit->position = pos;
+		unit->setPosition(pos);
 		unit->calculateScreenPosition();
 	}
 }
@@ -5,6 +5,7 @@
 
 #include "../../engine/core.hpp"
 #include "../../math/vec.hpp"
+#include "../util/particleloader.hpp"
 
 class Combat;
 class Unit;
@@ -26,7 +27,7 @@ enum class ParticlePosition {
 
 // Struct to keep track of particles
 struct ParticleData {
-	std::string name;
+	ParticleId id;
 	ParticlePosition position;
 };
 
@@ -64,7 +65,7 @@ public:
 	void addEffectModifier(Stat stat, float multiplier);
 
 	// Particle functions
-	void addParticle(std::string name, ParticlePosition pos);
+	void addParticle(ParticleId id, ParticlePosition pos);
 
 	// Utility methods
 	void renderValidGrid(int tile_width, int tile_height, const Combat& combat);
@@ -3,7 +3,6 @@
 #include "../../combat.hpp"
 #include "../../util/attackloader.hpp"
 
-#include <fstream>
 #include <iostream>
 
 BabyGoombaEnemy::BabyGoombaEnemy() :
@@ -24,10 +23,8 @@ BabyGoombaEnemy::BabyGoombaEnemy() :
 	int CON = 0;
 	// Load enemy data from file
 	const std::string filePath = "res/data/enemies/goomba.json";
-	std::ifstream file(filePath);
-	if (file.is_open()) {
-		json data;
-		file >> data;
+	json data;
+	if (Core::loadJson(filePath, data)) {
 
 		json stats = data["BABY GOOMBA"];
 		STR = stats["STR"];
@@ -5,7 +5,6 @@
 #include "../../util/attackloader.hpp"
 #include "../player.hpp"
 
-#include <fstream>
 #include <iostream>
 
 WarriorEnemy::WarriorEnemy() : 
@@ -26,10 +25,8 @@ WarriorEnemy::WarriorEnemy() :
 	int CON = 0;
 	// Load enemy data from file
 	const std::string filePath = "res/data/enemies/warrior.json";
-	std::ifstream file(filePath);
-	if (file.is_open()) {
-		json data;
-		file >> data;
+	json data;
+	if (Core::loadJson(filePath, data)) {
 
 		json stats = data["BASIC WARRIOR"];
 		STR = stats["STR"];
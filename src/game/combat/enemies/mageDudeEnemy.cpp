@@ -3,7 +3,6 @@
 #include "../../combat.hpp"
 #include "../../util/attackloader.hpp"
 
-#include <fstream>
 #include <iostream>
 
 MageDudeEnemy::MageDudeEnemy() :
@@ -26,10 +25,8 @@ MageDudeEnemy::MageDudeEnemy() :
 	int CON = 0;
 	// Load enemy data from file
 	const std::string filePath = "res/data/enemies/mage.json";
-	std::ifstream file(filePath);
-	if (file.is_open()) {
-		json data;
-		file >> data;
+	json data;
+	if (Core::loadJson(filePath, data)) {
 
 		json stats = data["MAGE DUDE"];
 		STR = stats["STR"];
@@ -18,7 +18,8 @@ Enemy::~Enemy()
 
 void Enemy::render()
 {
-	sprite.setPos(screenPosition.x(), screenPosition.y());
+	ScreenCoord pos = getRenderPosition();
+	sprite.setPos(pos.x(), pos.y());
 	sprite.render();
 
 	if (state != UnitState::DEAD) {
@@ -40,7 +41,7 @@ void Enemy::update(int delta) {
 			// If the enemy reaches the target destination, stop moving it
 			if (position.x() == moveTarget.x() && position.y() == moveTarget.y()) {
 				state = UnitState::IDLE;
-				position = moveTarget;
+				setPosition(moveTarget);
 				calculateScreenPosition();
 				// Assume that when the enemy only moves on its own turn
 				// THUS, handle enemy attack when it finishes moving
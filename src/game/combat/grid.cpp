@@ -2,7 +2,6 @@
 
 #include <cmath> 
 #include <set>
-#include <fstream>
 
 // File JSON handling
 #include <nlohmann/json.hpp>
@@ -15,16 +14,18 @@ Grid::Grid() :
 	map_height(DEFAULT_MAP_HEIGHT),
 	tilesheet("res/assets/tiles/tilesheet1.png")
 {
+	// Calculate the tilesheet size in tiles from the texture itself
+	source_width = tilesheet.original_w / SOURCE_TILE_WIDTH;
+	source_height = tilesheet.original_h / SOURCE_TILE_WIDTH;
 	init(SOURCE_TILE_WIDTH);
 }
 
 // Constructor to load the grid from file data
 // TODO: Add collision map loading in file data
 Grid::Grid(std::string file) : tilesheet("INVALID") {
-	std::ifstream inp(file);
-	// Use the provided overloaded operators to lead the json data
+	// Load the json data from the asset archive or the loose file
 	json data;
-	inp >> data;
+	Core::loadJson(file, data);
 
 	// Get the map width and height
 	map_width  = data["width"];
@@ -52,6 +53,11 @@ void Grid::update()
 {
 	SDL_GetMouseState(&mouseX, &mouseY);
 	mousePos = getMouseToGrid();
+
+	// Recalculate the tiles if the window was resized since the mesh was built
+	if (mesh_window_width != Core::windowWidth() || mesh_window_height != Core::windowHeight()) {
+		init(source_tile_size);
+	}
 }
 
 
@@ -92,10 +98,29 @@ void Grid::init(int source_tile_width) {
 	tilesheet.setSize(tile_width, tile_height);
 	source_tile_size = source_tile_width;
 
+	// Build the tilemap mesh now that all the tile properties are known
+	buildTileMesh();
+
 	// Debugging code
 	renderOutline = true;
 }
 
+void Grid::buildTileMesh() {
+	tileMesh.clear();
+	for (int y = 0; y < map_height; y++) {
+		for (int x = 0; x < map_width; x++) {
+			int index = tilemap[TILE_INDEX(x, y)];
+			tilesheet.setSourcePos(indexToX(index) * source_tile_size, indexToY(index) * source_tile_size);
+			tilesheet.setPos(tile_width * x, tile_height * y);
+			tileMesh.addSprite(tilesheet);
+		}
+	}
+	tileMesh.upload();
+
+	mesh_window_width = Core::windowWidth();
+	mesh_window_height = Core::windowHeight();
+}
+
 int Grid::indexToX(int index) const {
 	return index % source_width;
 }
@@ -106,27 +131,23 @@ int Grid::indexToY(int index) const {
 
 void Grid::render()
 {
-	for (int y = 0; y < map_height; y++) {
-		for (int x = 0; x < map_width; x++) {
-			int index = tilemap[TILE_INDEX(x, y)];
-			tilesheet.setSourcePos(indexToX(index) * source_tile_size, indexToY(index) * source_tile_size);
-			tilesheet.setPos(tile_width * x, tile_height * y);
-			tilesheet.render();
-		}
-	}
+	PROFILE_SCOPE("Grid::render");
+	// Draw the whole tilemap in one call
+	Core::Renderer::drawSpriteMesh(tileMesh, tilesheet.getTexture());
 
 	int thickness = 5;
 
 	// Render the debugging outline if set
 	if (renderOutline) {
-		Core::Renderer::setAlpha(.10f + .07f * sin(Core::getSeconds()));
+		float alpha = .10f + .07f * sin(Core::getSeconds());
 		// Render horizontal lines
 		for (int i = 1; i < map_height; ++i) {
 		Core::Renderer::drawRect(
 				ScreenCoord(0, tile_height * i),
 				Core::windowWidth(),
 				thickness,
-				Colour(1.f, 1.f, 1.f));
+				Colour(1.f, 1.f, 1.f),
+				alpha);
 		}
 		// Render vertical lines
 		for (int i = 0; i < map_width; ++i) {
@@ -134,8 +155,8 @@ void Grid::render()
 				ScreenCoord(tile_width * i, 0),
 				thickness,
 				Core::windowHeight(),
-				Colour(1.f, 1.f, 1.f));
+				Colour(1.f, 1.f, 1.f),
+				alpha);
 		}
-		Core::Renderer::setAlpha(1);
 	}
 }
\ No newline at end of file
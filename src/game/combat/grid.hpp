@@ -34,6 +34,10 @@ public:
 	Grid(std::string file);
 	~Grid();
 
+	// The grid owns GPU data for the tilemap, so it can only be moved
+	Grid(Grid&&) = default;
+	Grid& operator=(Grid&&) = default;
+
 	void render();
 	void update();
 
@@ -79,4 +83,11 @@ private:
 	// Grid sprites
 	Sprite tilesheet;
 
+	// The tiles never change during a battle, so they are prebuilt into a single mesh
+	void buildTileMesh();
+	SpriteMesh tileMesh;
+	// The window size the tile mesh was built for, the mesh is rebuilt if this changes
+	int mesh_window_width;
+	int mesh_window_height;
+
 };
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "pathfinder.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "../combat.hpp"
+
+Pathfinder::Pathfinder() :
+	map_width(0),
+	map_height(0),
+	search_id(0)
+{
+
+}
+
+std::vector<ScreenCoord> Pathfinder::findPath(const Combat & combat, ScreenCoord start, ScreenCoord goal, int max_steps) {
+	std::vector<ScreenCoord> result;
+
+	// Check to see if the target position is valid first
+	if (!combat.grid.isPosValid(start) || !combat.grid.isPosValid(goal)) return result;
+	if (start == goal) {
+		result.push_back(start);
+		return result;
+	}
+	if (!combat.isPosEmpty(goal)) return result;
+	if (std::abs(goal.x() - start.x()) + std::abs(goal.y() - start.y()) > max_steps) return result;
+
+	if (combat.grid.map_width != map_width || combat.grid.map_height != map_height) {
+		resize(combat.grid.map_width, combat.grid.map_height);
+	}
+	// Start a new search, the stamps only need to be cleared when the id wraps around
+	if (++search_id == 0) {
+		std::fill(visited.begin(), visited.end(), 0);
+		search_id = 1;
+	}
+
+	const int start_index = start.y() * map_width + start.x();
+	const int goal_index = goal.y() * map_width + goal.x();
+
+	open.clear();
+	visited[start_index] = search_id;
+	cost[start_index] = 0;
+	came_from[start_index] = -1;
+	open.push_back(Node{ std::abs(goal.x() - start.x()) + std::abs(goal.y() - start.y()), 0, start_index });
+
+	static const int offsets[4][2] = { { -1, 0 }, { 1, 0 }, { 0, 1 }, { 0, -1 } };
+	bool found = false;
+	while (!open.empty()) {
+		std::pop_heap(open.begin(), open.end(), NodeCompare());
+		Node node = open.back();
+		open.pop_back();
+
+		// Skip nodes that were already reached with a lower cost
+		if (node.g > cost[node.index]) continue;
+		if (node.index == goal_index) {
+			found = true;
+			break;
+		}
+		if (node.g >= max_steps) continue;
+
+		int x = node.index % map_width;
+		int y = node.index / map_width;
+		for (const auto& offset : offsets) {
+			ScreenCoord next(x + offset[0], y + offset[1]);
+			if (!combat.isPosEmpty(next)) continue;
+
+			int next_index = next.y() * map_width + next.x();
+			int next_cost = node.g + 1;
+			if (visited[next_index] == search_id && cost[next_index] <= next_cost) continue;
+
+			visited[next_index] = search_id;
+			cost[next_index] = next_cost;
+			came_from[next_index] = node.index;
+			int h = std::abs(goal.x() - next.x()) + std::abs(goal.y() - next.y());
+			open.push_back(Node{ next_cost + h, next_cost, next_index });
+			std::push_heap(open.begin(), open.end(), NodeCompare());
+		}
+	}
+
+	if (!found) return result;
+
+	// Walk the came from indices back to the start and reverse them into a path
+	result.reserve(cost[goal_index] + 1);
+	for (int index = goal_index; index != -1; index = came_from[index]) {
+		result.push_back(ScreenCoord(index % map_width, index / map_width));
+	}
+	std::reverse(result.begin(), result.end());
+	return result;
+}
+
+void Pathfinder::resize(int width, int height) {
+	map_width = width;
+	map_height = height;
+	int size = width * height;
+	cost.assign(size, 0);
+	came_from.assign(size, -1);
+	visited.assign(size, 0);
+	search_id = 0;
+	// Every tile can be pushed at most once per neighbour, so this is enough to never grow the heap
+	open.reserve(size * 4);
+}
+
+DistanceField::DistanceField() :
+	built(false),
+	max_steps(0),
+	occupancy_version(0),
+	map_width(0),
+	map_height(0)
+{
+
+}
+
+void DistanceField::build(const Combat & combat, ScreenCoord origin, int max_steps, unsigned int occupancy_version) {
+	this->origin = origin;
+	this->max_steps = max_steps;
+	this->occupancy_version = occupancy_version;
+	built = true;
+
+	map_width = combat.grid.map_width;
+	map_height = combat.grid.map_height;
+	steps.assign(map_width * map_height, -1);
+	parent.assign(map_width * map_height, -1);
+	reachable.clear();
+	reachable.reserve(map_width * map_height);
+
+	int origin_index = getIndex(origin);
+	if (origin_index < 0) return;
+	steps[origin_index] = 0;
+	reachable.push_back(origin);
+
+	static const int offsets[4][2] = { { -1, 0 }, { 1, 0 }, { 0, 1 }, { 0, -1 } };
+	// The reachable list doubles as the queue since tiles are visited in breadth first order
+	for (unsigned int head = 0; head < reachable.size(); ++head) {
+		ScreenCoord current = reachable[head];
+		int current_index = getIndex(current);
+		int current_steps = steps[current_index];
+		if (current_steps >= max_steps) continue;
+
+		for (const auto& offset : offsets) {
+			ScreenCoord next(current.x() + offset[0], current.y() + offset[1]);
+			if (!combat.isPosEmpty(next)) continue;
+
+			int next_index = getIndex(next);
+			if (steps[next_index] >= 0) continue;
+			steps[next_index] = current_steps + 1;
+			parent[next_index] = current_index;
+			reachable.push_back(next);
+		}
+	}
+}
+
+bool DistanceField::isBuiltFor(ScreenCoord origin, int max_steps, unsigned int occupancy_version) const {
+	return built && this->origin == origin && this->max_steps == max_steps && this->occupancy_version == occupancy_version;
+}
+
+int DistanceField::getSteps(ScreenCoord pos) const {
+	int index = getIndex(pos);
+	if (index < 0) return -1;
+	return steps[index];
+}
+
+std::vector<ScreenCoord> DistanceField::getPath(ScreenCoord pos) const {
+	std::vector<ScreenCoord> result;
+	int index = getIndex(pos);
+	if (index < 0 || steps[index] < 0) return result;
+
+	result.reserve(steps[index] + 1);
+	for (; index != -1; index = parent[index]) {
+		result.push_back(ScreenCoord(index % map_width, index / map_width));
+	}
+	std::reverse(result.begin(), result.end());
+	return result;
+}
+
+int DistanceField::getIndex(ScreenCoord pos) const {
+	if (pos.x() < 0 || pos.x() >= map_width) return -1;
+	if (pos.y() < 0 || pos.y() >= map_height) return -1;
+	return pos.y() * map_width + pos.x();
+}
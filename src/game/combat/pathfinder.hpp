@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../../math/vec.hpp"
+
+#include <vector>
+
+class Combat;
+
+/*	A* pathfinder over the combat grid
+		- All of the search state is stored in flat arrays indexed by tile (y * map_width + x)
+		- The open list is a binary heap and the path is rebuilt from came from indices
+		- Buffers are only reallocated when the map size changes, searching never allocates
+			except for the returned path
+		- Tiles are stamped with a search id instead of clearing the arrays between searches
+*/
+class Pathfinder {
+
+public:
+	Pathfinder();
+
+	// Find the shortest path from start to goal that takes at most max_steps moves
+	// The path includes the start position, an empty path means the goal can't be reached
+	std::vector<ScreenCoord> findPath(const Combat& combat, ScreenCoord start, ScreenCoord goal, int max_steps);
+
+private:
+
+	// A node in the open list, nodes are never updated in place so stale copies are skipped when popped
+	struct Node {
+		int f;
+		int g;
+		int index;
+	};
+	// Comparator to turn the std heap functions into a min heap on f, preferring deeper nodes on ties
+	struct NodeCompare {
+		inline bool operator() (const Node& a, const Node& b) const {
+			if (a.f != b.f) return a.f > b.f;
+			return a.g < b.g;
+		}
+	};
+
+	void resize(int width, int height);
+
+	int map_width;
+	int map_height;
+
+	// Per tile search state
+	std::vector<int> cost;
+	std::vector<int> came_from;
+	std::vector<unsigned int> visited;
+	unsigned int search_id;
+
+	std::vector<Node> open;
+
+};
+
+/*	Bounded breadth first search from a single tile
+		- Stores the step count and the parent tile of every tile reachable within max_steps moves
+		- Any reachable tile can be checked or traced back to the origin without searching again
+		- Remembers the origin, step limit and board occupancy version it was built for so
+			the owner can tell when it needs to be rebuilt
+*/
+class DistanceField {
+
+public:
+	DistanceField();
+
+	void build(const Combat& combat, ScreenCoord origin, int max_steps, unsigned int occupancy_version);
+	bool isBuiltFor(ScreenCoord origin, int max_steps, unsigned int occupancy_version) const;
+
+	// Number of steps to reach the position, -1 if it can't be reached
+	int getSteps(ScreenCoord pos) const;
+	inline bool isReachable(ScreenCoord pos) const { return getSteps(pos) >= 0; }
+	// The path from the origin to the position including both ends, empty if it can't be reached
+	std::vector<ScreenCoord> getPath(ScreenCoord pos) const;
+	// Every reachable tile in the order it was found, starting with the origin
+	inline const std::vector<ScreenCoord>& getReachable() const { return reachable; }
+
+private:
+
+	int getIndex(ScreenCoord pos) const;
+
+	bool built;
+	ScreenCoord origin;
+	int max_steps;
+	unsigned int occupancy_version;
+
+	int map_width;
+	int map_height;
+
+	// Per tile search results
+	std::vector<int> steps;
+	std::vector<int> parent;
+
+	// The tiles in the order they were visited, also used as the search queue
+	std::vector<ScreenCoord> reachable;
+
+};
@@ -37,7 +37,7 @@ Player::Player(int x, int y, const nlohmann::json& data) :
 Player::~Player() {}
 
 void Player::renderBottom(Combat * combat) {
-	shadow.render();
+	renderShadow();
 	if (player_state == PlayerState::ATTACKING) {
 		// Render the corresponding UI elements depending on the players current action
 		if (current_action == PlayerAction::MOVE && state == UnitState::IDLE) {
@@ -61,7 +61,8 @@ void Player::renderBottom(Combat * combat) {
 void Player::render()
 {
 	// Render the actual player
-	player_sprite.setPos(screenPosition.x(), screenPosition.y());
+	ScreenCoord pos = getRenderPosition();
+	player_sprite.setPos(pos.x(), pos.y());
 	player_sprite.render();
 }
 
@@ -300,7 +301,7 @@ void Player::update(int delta) {
 				if (position.x() == moveTarget.x() && position.y() == moveTarget.y()) {
 					state = UnitState::IDLE;
 					current_action = PlayerAction::NONE;
-					position = moveTarget;
+					setPosition(moveTarget);
 					calculateScreenPosition();
 					if (moved) {
 						state = UnitState::DONE;
@@ -399,41 +400,11 @@ void Player::execute(Vec2<int> to)
 }
 
 void Player::setPathLine(Vec2<int> dest) {
-	path_line = getPath(*combat, dest);
+	path_line = getMoveField().getPath(dest);
 }
 
 std::vector<ScreenCoord> Player::getPossibleMoves() {
-	std::vector<std::vector<ScreenCoord>> open;
-	std::vector<ScreenCoord> seen;
-
-	std::vector<ScreenCoord> root;
-	root.push_back(position);
-
-	open.push_back(root);
-	while (!(open.empty())) {
-		std::vector<ScreenCoord> n = open[0];
-		open.erase(open.begin());
-
-		if (n.size() <= static_cast<unsigned int>(getMoveSpeed() + 1)) {
-			//continue;
-
-			ScreenCoord end_position = n.back();
-			if (std::find(seen.begin(), seen.end(), end_position) != seen.end()) {
-				continue;
-			}
-
-			seen.push_back(end_position);
-
-			std::vector<ScreenCoord> successors = getValidNeighbours(end_position, *combat);
-			for (ScreenCoord succ : successors) {
-				std::vector<ScreenCoord> s(n);
-				s.push_back(succ);
-				open.push_back(s);
-			}
-		}
-	}
-
-	return seen;
+	return getMoveField().getReachable();
 }
 
 void Player::updatePossibleMoves()
@@ -5,6 +5,7 @@
 
 // TODO: Design better constructors
 Unit::Unit(UnitType type) :
+	combat(nullptr),
 	type(type),
 	state(UnitState::IDLE),
 	sprite_width(DEFAULT_SPRITE_WIDTH),
@@ -12,7 +13,8 @@ Unit::Unit(UnitType type) :
 	top_margin(0),
 	shadow("res/assets/shadow.png"),
 	unit_width(-1),
-	unit_height(-1)
+	unit_height(-1),
+	move_tick(0)
 {
 	generateDefaultUnitData();
 	loadPropertiesFromUnitData();
@@ -75,56 +77,17 @@ void Unit::setTopMargin(int margin) {
 }
 
 std::vector<ScreenCoord> Unit::getPath(Combat & combat, ScreenCoord to) {
-	std::vector<std::vector<ScreenCoord>> open;
-
-	std::vector<ScreenCoord> root;
-	root.push_back(position);
-
-	// Check to see if the target position is valid first
-	if (!combat.grid.isPosValid(to)) return std::vector<ScreenCoord>();
-
-	open.push_back(root);
-	while (!(open.empty())) {
-		std::vector<ScreenCoord> n = heuristic(&open);
-		std::vector<std::vector<ScreenCoord>>::iterator index = std::find(open.begin(), open.end(), n);
-		open.erase(index);
-
-		if (n.size() <= static_cast<unsigned int>(getMoveSpeed() + 1)) {
-
-			ScreenCoord end_position = n.back();
-			if (end_position.x() == to.x() && end_position.y() == to.y()) {
-				//n is solution
-				return n;
-			}
-
-			std::vector<ScreenCoord> successors = getValidNeighbours(end_position, combat);
-			for (ScreenCoord succ : successors) {
-				std::vector<ScreenCoord> s(n);
-				s.push_back(succ);
-				open.push_back(s);
-			}
-		}
-	}
-
-	// No solution found
-	std::vector<ScreenCoord> result;
-	return result;
+	PROFILE_SCOPE("Unit::getPath");
+	// The unit can't take more steps than its movement speed allows
+	return combat.pathfinder.findPath(combat, position, to, getMoveSpeed());
 }
 
-std::vector<ScreenCoord> Unit::heuristic(std::vector<std::vector<ScreenCoord>>* open) {
-	std::vector<ScreenCoord> smallest;
-	int smallest_dist = 99999;
-	for (std::vector<ScreenCoord> node : *open) {
-		ScreenCoord end_position = node.back();
-		int x_diff = std::abs(end_position.x() - moveTarget.x());
-		int y_diff = std::abs(end_position.y() - moveTarget.y());
-		ScreenCoord v(x_diff, y_diff);
-		if (v.norm() < smallest_dist) {
-			smallest_dist = v.norm();
-			smallest = node;
-		}
+const DistanceField & Unit::getMoveField() {
+	if (!move_field.isBuiltFor(position, getMoveSpeed(), combat->getOccupancyVersion())) {
+		PROFILE_SCOPE("DistanceField::build");
+		move_field.build(*combat, position, getMoveSpeed(), combat->getOccupancyVersion());
 	}
-	return smallest;
+	return move_field;
 }
 
 std::vector<ScreenCoord> Unit::getValidNeighbours(ScreenCoord pos, Combat & combat) {
@@ -161,6 +124,10 @@ std::vector<ScreenCoord> Unit::getValidNeighbours(ScreenCoord pos, Combat & comb
 }
 
 void Unit::calculateScreenPositionMovement() {
+	// Remember where the unit was so rendering can interpolate between the two ticks
+	previousScreenPosition = screenPosition;
+	move_tick = Core::getSimTicks();
+
 	screenPosition.x() += moveNext.x() * tile_width / 12;
 	screenPosition.y() += moveNext.y() * tile_height / 12;
 
@@ -169,7 +136,7 @@ void Unit::calculateScreenPositionMovement() {
 }
 
 void Unit::incrementMovement() {
-	position += moveNext;
+	setPosition(position + moveNext);
 
 	//nothing left
 	if (path.size() <= 0) return;
@@ -182,11 +149,18 @@ void Unit::incrementMovement() {
 	calculateScreenPosition();
 }
 
+void Unit::setPosition(Vec2<int> pos) {
+	if (combat) combat->updateOccupancy(this, position, pos);
+	position = pos;
+}
+
 void Unit::calculateScreenPosition() {
 	screenPosition.x() = position.x() * tile_width;
 	screenPosition.y() = position.y() * tile_height;
 	screenPosition.x() += (tile_width - sprite_width) / 2;
 	screenPosition.y() -= sprite_height - tile_height;
+	// Jumps to a new position shouldn't be interpolated
+	previousScreenPosition = screenPosition;
 	// Calculate shadow positions
 	shadow.setPos(position.x() * tile_width, position.y() * tile_height + tile_height / 2);
 }
@@ -259,7 +233,7 @@ void Unit::push(int p, ScreenCoord src_pos) {
 		for (int i = p; i >= 0; i--) {
 			temp_pos = position - Vec2<int>(1 * p, 0);
 			if (combat->isPosEmpty(temp_pos)) {
-				position = temp_pos;
+				setPosition(temp_pos);
 				calculateScreenPosition();
 				break;
 			}
@@ -269,7 +243,7 @@ void Unit::push(int p, ScreenCoord src_pos) {
 		for (int i = p; i >= 0; i--) {
 			temp_pos = position - Vec2<int>(-1 * p, 0);
 			if (combat->isPosEmpty(temp_pos)) {
-				position = temp_pos;
+				setPosition(temp_pos);
 				calculateScreenPosition();
 				break;
 			}
@@ -279,7 +253,7 @@ void Unit::push(int p, ScreenCoord src_pos) {
 		for (int i = p; i >= 0; i--) {
 			temp_pos = position - Vec2<int>(0, 1 * p);
 			if (combat->isPosEmpty(temp_pos)) {
-				position = temp_pos;
+				setPosition(temp_pos);
 				calculateScreenPosition();
 				break;
 			}
@@ -289,7 +263,7 @@ void Unit::push(int p, ScreenCoord src_pos) {
 		for (int i = p; i >= 0; i--) {
 			temp_pos = position - Vec2<int>(0, -1 * p);
 			if (combat->isPosEmpty(temp_pos)) {
-				position = temp_pos;
+				setPosition(temp_pos);
 				calculateScreenPosition();
 				break;
 			}
@@ -301,17 +275,15 @@ bool Unit::move(Combat & combat, Vec2<int> pos) {
 	// Only move the player to empty positions
 	if (combat.isPosEmpty(pos)) {
 		// Also check if the movement is valid first
-		int steps = std::abs(pos.x() - position.x()) + std::abs(pos.y() - position.y());
-		if (steps <= getMoveSpeed()) {
+		const DistanceField& field = getMoveField();
+		if (field.isReachable(pos)) {
 			moveTarget = pos;
-			path = getPath(combat, moveTarget);
-			if (path.size() > 0) {
-				moveNext = ScreenCoord(0, 0);
-				incrementMovement();
-				state = UnitState::MOVE;
-				startCounter();
-				return true;
-			}
+			path = field.getPath(moveTarget);
+			moveNext = ScreenCoord(0, 0);
+			incrementMovement();
+			state = UnitState::MOVE;
+			startCounter();
+			return true;
 		}
 	}
 	return false;
@@ -319,7 +291,27 @@ bool Unit::move(Combat & combat, Vec2<int> pos) {
 
 void Unit::renderBottom(Combat * combat) {
 	// For now, just render the shadow of the unit on the bottom
+	renderShadow();
+}
+
+void Unit::renderShadow() {
+	// The shadow is placed whenever the unit moves, resting shadows are computed from the tile position
+	// so only shift it by how far the interpolated position is from the simulated one
+	int x = shadow.x;
+	int y = shadow.y;
+	ScreenCoord pos = getRenderPosition();
+	shadow.setPos(x + pos.x() - screenPosition.x(), y + pos.y() - screenPosition.y());
 	shadow.render();
+	shadow.setPos(x, y);
+}
+
+ScreenCoord Unit::getRenderPosition() const {
+	// Only interpolate if the unit actually moved during the latest simulation tick
+	if (move_tick != Core::getSimTicks()) return screenPosition;
+	float t = Core::getInterpolation();
+	ScreenCoord from = previousScreenPosition;
+	ScreenCoord to = screenPosition;
+	return ScreenCoord(lerp(from.x(), to.x(), t), lerp(from.y(), to.y(), t));
 }
 
 void Unit::renderTop(Combat * combat) {
@@ -328,7 +320,7 @@ void Unit::renderTop(Combat * combat) {
 
 void Unit::renderHealth() {
 	// ScreenCoord pos = screenPosition + ScreenCoord((tile_width - sprite_width) / 2, (tile_height - sprite_height) / 2);
-	ScreenCoord pos = screenPosition;
+	ScreenCoord pos = getRenderPosition();
 	if (unit_height > 0) {
 		pos.y() += sprite_height - unit_height;
 	}
@@ -363,7 +355,4 @@ void Unit::loadPropertiesFromUnitData(bool resetHealth) {
 	}
 	// The movement speed in terms of grid units of the unit
 	move_speed = getDEX() / 5 + 1;
-	// TEMPORARY HARD CAP, CHANGE THIS BY OPTIMIZING IN THE FUTURE
-	// TODO: Profile pathfinding code to find bottleneck
-	if (move_speed > 4) move_speed = 4;
 }
@@ -6,6 +6,7 @@
 
 #include "attack.hpp"
 #include "status.hpp"
+#include "pathfinder.hpp"
 #include "../unitData.hpp"
 
 #define DEFAULT_SPRITE_WIDTH	300
@@ -43,6 +44,8 @@ public:
 	Vec2<int> position;
 	// The position of the unit in terms of screen coordinates
 	ScreenCoord screenPosition;
+	// The screen position to draw the unit at, in between the last two simulation ticks
+	ScreenCoord getRenderPosition() const;
 
 	// Render methods
 	virtual void renderBottom(Combat * combat);
@@ -65,6 +68,8 @@ public:
 
 	// Helper method to calculate the screen position based on grid position
 	void calculateScreenPosition();
+	// Changes the grid position of the unit, keeping the combat occupancy index up to date
+	void setPosition(Vec2<int> pos);
 
 	// Setter methods
 	void setTileSize(int width, int height);
@@ -120,8 +125,10 @@ protected:
 	// Helper variables for unit movement
 	std::vector<ScreenCoord> getPath(Combat & combat, ScreenCoord to);
 	// Pathfinding helper methods
-	std::vector<ScreenCoord> heuristic(std::vector<std::vector<ScreenCoord>> * open);
 	std::vector<ScreenCoord> getValidNeighbours(ScreenCoord pos, Combat & combat);
+	// The tiles the unit can move to this turn, rebuilt only when the unit or the board changes
+	const DistanceField& getMoveField();
+	DistanceField move_field;
 	// Helper functions to calculate the screen position and movement of the player
 	void calculateScreenPositionMovement();
 	void incrementMovement();
@@ -142,6 +149,11 @@ protected:
 
 	// Common sprites used by most units
 	Sprite shadow;
+	void renderShadow();
+
+	// Screen position before the last movement tick, used to interpolate rendering
+	ScreenCoord previousScreenPosition;
+	unsigned int move_tick;
 
 private:
 
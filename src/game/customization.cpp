@@ -108,8 +108,9 @@ void Customization::initSprites() {
 	base.setSize(SubDiv::hSize(2, 1), SubDiv::vSize(2, 1));
 	empty.setSize(SubDiv::hSize(2, 1), SubDiv::vSize(2, 1));
 
-	int width = Core::getTexture("res/assets/UI/Continue.png")->getWidth();
-	int height = Core::getTexture("res/assets/UI/Continue.png")->getHeight();
+	Vec2<int> size = Core::getImageSize("res/assets/UI/Continue.png");
+	int width = size.x();
+	int height = size.y();
 	continueButton = ButtonData(ScreenCoord(SubDiv::hCenter() - width / 2, 0), width, height);
 	continueButton.setSprites("res/assets/UI/Continue.png", "res/assets/UI/ContinueHover.png", "res/assets/UI/ContinueHover.png");
 }
@@ -320,9 +321,8 @@ void Customization::switchToCombatState() {
 	level_id++;
 	// Change the state based on the level file
 	std::string combatLevelLocation;
-	std::ifstream masterFile(DEFAULT_MASTER_FILE);
 	json masterData;
-	masterFile >> masterData;
+	Core::loadJson(DEFAULT_MASTER_FILE, masterData);
 	// TODO: Temporary, change this in the future
 	bool level_found = false;
 	for (const json& level : masterData["levels"]) {
@@ -340,7 +340,6 @@ void Customization::switchToCombatState() {
 		}
 	}
 	save_file.close();
-	masterFile.close();
 	if (level_found) {
 		// Save the new level to the game
 		inputData["level"] = level_id;
@@ -352,9 +351,8 @@ void Customization::switchToCombatState() {
 }
 
 void Customization::initAvailableAttacks() {
-	std::ifstream attacks_file(DEFAULT_ATTACK_FILE);
 	json attacks_data;
-	attacks_file >> attacks_data;
+	Core::loadJson(DEFAULT_ATTACK_FILE, attacks_data);
 
 	for (unsigned int i = 0; i < units.size(); ++i) {
 		attacks.push_back(std::vector<std::string>());
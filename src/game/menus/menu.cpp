@@ -32,6 +32,23 @@ Menu::Menu(bool start_music) :
 
 	SDL_ShowCursor(SDL_DISABLE);
 
+	// Warm up the textures every combat needs while the player is still in the menu
+	Core::prefetchTextures({
+		"res/assets/tiles/tilesheet1.png",
+		"res/assets/tiles/valid.png",
+		"res/assets/tiles/valid_circle.png",
+		"res/assets/tiles/invalid_circle.png",
+		"res/assets/tiles/valid_move.png",
+		"res/assets/tiles/particles.png",
+		"res/assets/players/FemaleSheet.png",
+		"res/assets/enemies/babygoomba.png",
+		"res/assets/enemies/warrior.png",
+		"res/assets/enemies/mage.png",
+		"res/assets/shadow.png",
+		"res/assets/UI/pauseBase.png",
+		"res/assets/UI/game_over/base.png"
+	});
+
 	// Play menu music
 	if (start_music) {
 		Core::Mixer::loadAudio("res/music/track1.wav", AudioType::Music);
@@ -170,9 +187,8 @@ void Menu::changeToCombatState() {
 	// Change the state based on the level file
 	bool has_cutscene = false;
 	std::string combatLevelLocation;
-	std::ifstream masterFile(MASTER_LEVEL_LOCATION);
 	json masterData;
-	masterFile >> masterData;
+	Core::loadJson(MASTER_LEVEL_LOCATION, masterData);
 	for (const json& level : masterData["levels"]) {
 		if (level["id"] == level_id) {
 			// TOOD: not sure if this swap is necessary, but I think the code breaks otherwise
@@ -181,8 +197,10 @@ void Menu::changeToCombatState() {
 			// If a cutscene is found, switch to it
 			if (level.find("cutscene") != level.end()) {
 				has_cutscene = true;
+				std::vector<std::string> images = level["cutscene"]["images"];
+				Core::prefetchTextures(images);
 				Cutscene * cutscene = new Cutscene(new Combat(combatLevelLocation));
-				for (std::string img : level["cutscene"]["images"]) {
+				for (const std::string& img : images) {
 					cutscene->addSprite(img);
 				}
 				changeState(cutscene);
@@ -149,9 +149,8 @@ SkillTree::SkillTree(int playerId, const std::string & skillTreePath) :
 	icons(NODE_ICONS_FILE)
 {
 	{	// Read skill tree data from a file
-		std::ifstream f(skillTreePath);
 		json data;
-		f >> data;
+		Core::loadJson(skillTreePath, data);
 		height = data["height"];
 		for (const json& node : data["nodes"]) {
 			int id = node["id"];
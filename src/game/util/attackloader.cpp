@@ -7,7 +7,8 @@
 #define LOG(x)
 #endif
 
-#include <fstream>
+#include "../../engine/profiler.hpp"
+#include "../../engine/assetArchive.hpp"
 
 Attack AttackLoader::get(const std::string& name, Unit * unit) {
 	if (attacks.find(name) == attacks.end()) return Attack("INVALID", unit, AttackType::INVALID);
@@ -24,10 +25,10 @@ AttackLoader::~AttackLoader() {
 
 // The helper function to load all attack data from a file
 void AttackLoader::loadAttacks() {
-	std::ifstream inp(ATTACK_FILE_LOCATION);
-	// Use the provided overloaded operators to load the json data
+	PROFILE_SCOPE("AttackLoader::loadAttacks");
+	// Load the json data from the asset archive or the loose file
 	json data;
-inp >> data;
+	AssetArchive::get_instance().loadJson(ATTACK_FILE_LOCATION, data);
 
 // Load all the attacks individually
 for (const json& attack : data["attacks"]) {
@@ -38,6 +39,7 @@ for (const json& attack : data["attacks"]) {
 // The helper function to load an attack to the map based on its json data
 // TODO: return false if an attack failed to load
 bool AttackLoader::loadAttack(const json & data) {
+	PROFILE_SCOPE("AttackLoader::loadAttack");
 
 	std::string name = data["name"];
 	AttackType type = getTypeFromString(data["type"]);
@@ -64,12 +66,18 @@ bool AttackLoader::loadAttack(const json & data) {
 	}
 	// Parse the particles here
 	for (const json& particle : data["particles"]) {
+		// Resolve the name once here so attacks spawn particles by id
 		std::string particle_name = particle["name"];
+		ParticleId particle_id = Particles::getId(particle_name);
+		if (particle_id == INVALID_PARTICLE_ID) {
+			LOG("Unknown particle " << particle_name << " in attack " << name);
+			continue;
+		}
 		if (particle["position"] == "TARGET") {
-			attacks[name].addParticle(particle_name, ParticlePosition::TARGET);
+			attacks[name].addParticle(particle_id, ParticlePosition::TARGET);
 		}
 		if (particle["position"] == "SELF") {
-			attacks[name].addParticle(particle_name, ParticlePosition::SELF);
+			attacks[name].addParticle(particle_id, ParticlePosition::SELF);
 		}
 	}
 	return true;
@@ -1,4 +1,6 @@
 #include "particleloader.hpp"
+#include "../../engine/profiler.hpp"
+#include "../../engine/assetArchive.hpp"
 #pragma once
 
 #ifdef _DEBUG
@@ -8,40 +10,15 @@
 #define LOG(x)
 #endif
 
-#include <fstream>
-
-Emitter * ParticleLoader::get(const std::string & name, int x, int y) {
-	if (emitters.find(name) == emitters.end()) return nullptr;
-	Emitter * emitter = new Emitter(x, y,
-		emitters[name].angle,
-		emitters[name].spread,
-		emitters[name].max_y,
-		emitters[name].lifespan,
-		emitters[name].spawnrate,
-		emitters[name].burst,
-		emitters[name].speed,
-		emitters[name].particle_lifespan,
-		emitters[name].spawn_radius,
-		emitters[name].gravity);
-	emitter->SetSprite(emitters[name].source_x, emitters[name].source_y, emitters[name].source_w, emitters[name].source_h);
-	return emitter;
+ParticleId ParticleLoader::getId(const std::string & name) const {
+	auto it = ids.find(name);
+	if (it == ids.end()) return INVALID_PARTICLE_ID;
+	return it->second;
 }
 
-Emitter * ParticleLoader::get(const std::string & name, int x, int y, int angle) {
-	if (emitters.find(name) == emitters.end()) return nullptr;
-	Emitter * emitter = new Emitter(x, y,
-		angle,
-		emitters[name].spread,
-		emitters[name].max_y,
-		emitters[name].lifespan,
-		emitters[name].spawnrate,
-		emitters[name].burst,
-		emitters[name].speed,
-		emitters[name].particle_lifespan,
-		emitters[name].spawn_radius,
-		emitters[name].gravity);
-	emitter->SetSprite(emitters[name].source_x, emitters[name].source_y, emitters[name].source_w, emitters[name].source_h);
-	return emitter;
+const Emitter * ParticleLoader::getTemplate(ParticleId id) const {
+	if (id >= templates.size()) return nullptr;
+	return &templates[id];
 }
 
 ParticleLoader::ParticleLoader() {
@@ -53,10 +30,10 @@ ParticleLoader::~ParticleLoader() {
 }
 
 void ParticleLoader::loadParticles() {
-	std::ifstream inp(PARTICLE_FILE_LOCATION);
-	// Use the provided overloaded operators to load the json data
+	PROFILE_SCOPE("ParticleLoader::loadParticles");
+	// Load the json data from the asset archive or the loose file
 	json data;
-	inp >> data;
+	AssetArchive::get_instance().loadJson(PARTICLE_FILE_LOCATION, data);
 
 	// Load all the attacks individually
 	for (const json& particle : data["particles"]) {
@@ -65,21 +42,30 @@ void ParticleLoader::loadParticles() {
 }
 
 void ParticleLoader::loadParticle(const json & data) {
+	PROFILE_SCOPE("ParticleLoader::loadParticle");
 	std::string name = data["name"];
-	emitters[name] = EmitterData();
-	emitters[name].angle = data["angle"];
-	emitters[name].spread = data["spread"];
-	emitters[name].max_y = data["max_y"];
-	emitters[name].lifespan = data["lifespan"];
-	emitters[name].spawnrate = data["spawnrate"];
-	emitters[name].burst = data["burst"];
-	emitters[name].speed = data["speed"];
-	emitters[name].particle_lifespan = data["particle_lifespan"];
-	emitters[name].spawn_radius = data["spawn_radius"];
-	emitters[name].gravity = data["gravity"];
+	// The position is set when the particle is spawned
+	Emitter emitter(0, 0,
+		data["angle"],
+		data["spread"],
+		data["max_y"],
+		data["lifespan"],
+		data["spawnrate"],
+		data["burst"],
+		data["speed"],
+		data["particle_lifespan"],
+		data["spawn_radius"],
+		data["gravity"]);
+	const json& image = data["image_data"];
+	emitter.SetSprite(image["x"], image["y"], image["width"], image["height"]);
 
-	emitters[name].source_x = data["image_data"]["x"];
-	emitters[name].source_y = data["image_data"]["y"];
-	emitters[name].source_w = data["image_data"]["width"];
-	emitters[name].source_h = data["image_data"]["height"];
+	// A particle that is defined again replaces the earlier template, so ids handed out stay valid
+	auto it = ids.find(name);
+	if (it != ids.end()) {
+		templates[it->second] = emitter;
+	}
+	else {
+		ids[name] = static_cast<ParticleId>(templates.size());
+		templates.push_back(emitter);
+	}
 }
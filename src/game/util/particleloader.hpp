@@ -1,5 +1,6 @@
 #pragma once
 #include <unordered_map>
+#include <vector>
 
 // File JSON handling
 #include <nlohmann/json.hpp>
@@ -10,28 +11,14 @@ using json = nlohmann::json;
 // The path to the location where the attack data is stored
 #define PARTICLE_FILE_LOCATION	"res/data/particles.json"
 
-// Utility structs
-struct EmitterData {
-	int angle;
-	int spread;
-	int max_y;
-	int lifespan;
-	int spawnrate;
-	bool burst;
-	int speed;
-	int particle_lifespan;
-	int spawn_radius;
-	bool gravity;
-	
-	// Source sprite data
-	int source_x;
-	int source_y;
-	int source_w;
-	int source_h;
-};
+// Particles are referred to by the index of their emitter template
+typedef unsigned int ParticleId;
+#define INVALID_PARTICLE_ID	0xFFFFFFFF
 
 /*	A utility class that loads all particle data and stores it in a static container
 		- The class is stored as a singleton, it can and should never be instantiated by any other method
+		- Every particle is compiled into an emitter template on load, names are resolved to ids
+			once so spawning only copies the template
 
 	TODO:
 		- Handle load failures better
@@ -52,9 +39,10 @@ public:
 	ParticleLoader& operator=(ParticleLoader const&) = delete;  // Copy assign
 	ParticleLoader& operator=(ParticleLoader&&) = delete;		// Move assign
 
-	// The central get function to get the attack data and associate it with a unit
-	Emitter * get(const std::string& name, int x, int y);
-	Emitter * get(const std::string& name, int x, int y, int angle);
+	// The id of a particle name, INVALID_PARTICLE_ID if there is no such particle
+	ParticleId getId(const std::string& name) const;
+	// The emitter template of a particle, nullptr for invalid ids
+	const Emitter * getTemplate(ParticleId id) const;
 
 protected:
 	// Protected constructor/destructor for singleton pattern
@@ -66,17 +54,18 @@ private:
 	void loadParticles();
 	void loadParticle(const json& data);
 
-	// The actual storage of the attacks
-	std::unordered_map<std::string, EmitterData> emitters;
+	// The emitter templates indexed by id and the ids of the particle names
+	std::vector<Emitter> templates;
+	std::unordered_map<std::string, ParticleId> ids;
 
 };
 
 // Utility functions to interact with the particle loader more easily
 namespace Particles {
-	inline Emitter * get(const std::string& name, int x, int y) {
-		return ParticleLoader::get_instance().get(name, x , y);
+	inline ParticleId getId(const std::string& name) {
+		return ParticleLoader::get_instance().getId(name);
 	}
-	inline Emitter * get(const std::string& name, int angle, int x, int y) {
-		return ParticleLoader::get_instance().get(name, x, y, angle);
+	inline const Emitter * getTemplate(ParticleId id) {
+		return ParticleLoader::get_instance().getTemplate(id);
 	}
 }
\ No newline at end of file
@@ -12,6 +12,8 @@
 #include "game/combat.hpp"
 #include "game/customization.hpp"
 #include "game/skillTree.hpp"
+#include "game/util/attackloader.hpp"
+#include "game/util/particleloader.hpp"
 
 int main(int argc, char* argv[]) {
 
@@ -23,6 +25,9 @@ int main(int argc, char* argv[]) {
 
 	Core::setDebugMode(true);
 
+	// Parse the combat data while the menu is shown
+	Core::preloadJson({ ATTACK_FILE_LOCATION, PARTICLE_FILE_LOCATION });
+
 	// Combat * state = new Combat("res/data/levels/level1.json");
 	// Combat * state = new Combat();
 	// Customization * state = new Customization();
@@ -0,0 +1,167 @@
+/*	Offline asset packer
+		- Packs images and json data files into a single archive the game memory maps on startup
+		- Images are stored as raw RGBA, already flipped for OpenGL, so loading them is a
+			plain upload with no inflating or flipping
+		- Json files are stored as MessagePack, which parses without any text handling
+		- Images that are packed into the texture atlas are left out since the game only
+			ever loads their atlas page, build the atlas first so its pages get packed too
+		- Save files are written by the game and are never packed
+
+	Usage:
+		AssetPacker <output file> <input directory>...
+		e.g. AssetPacker res/assets.pak res/assets res/atlas res/data, run from the repository
+		root so the paths in the archive match the paths used by the game
+*/
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image/stb_image.h>
+
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+#include "../src/engine/assetArchive.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Name of the atlas lookup table, has to match ATLAS_FILE in the engine
+#define ATLAS_TABLE_NAME	"atlas.json"
+// Files the game writes to at runtime
+#define SAVE_FILE_NAME		"save.json"
+
+struct Asset {
+	std::string path;
+	AssetType type;
+	int width, height;
+	std::vector<unsigned char> data;
+};
+
+bool loadImage(const std::string& path, Asset& asset) {
+	int channels;
+	unsigned char * pixels = stbi_load(path.c_str(), &asset.width, &asset.height, &channels, 4);
+	if (!pixels) return false;
+	asset.data.assign(pixels, pixels + asset.width * asset.height * 4);
+	stbi_image_free(pixels);
+	return true;
+}
+
+bool loadData(const std::string& path, Asset& asset) {
+	std::ifstream file(path);
+	if (!file.is_open()) return false;
+	json data;
+	try {
+		file >> data;
+	}
+	catch (const json::parse_error& e) {
+		std::cerr << e.what() << std::endl;
+		return false;
+	}
+	asset.data = json::to_msgpack(data);
+	return true;
+}
+
+size_t align(size_t offset) {
+	return (offset + ASSET_ARCHIVE_ALIGNMENT - 1) / ASSET_ARCHIVE_ALIGNMENT * ASSET_ARCHIVE_ALIGNMENT;
+}
+
+int main(int argc, char * argv[]) {
+	if (argc < 3) {
+		std::cerr << "Usage: AssetPacker <output file> <input directory>..." << std::endl;
+		return 1;
+	}
+	std::string output(argv[1]);
+
+	// Paths are sorted so the archive is the same every time the assets are the same
+	std::set<std::string> images;
+	std::set<std::string> dataFiles;
+	for (int i = 2; i < argc; ++i) {
+		// The atlas directory only exists once the atlas has been built
+		if (!fs::is_directory(argv[i])) {
+			std::cerr << "Skipping missing directory " << argv[i] << std::endl;
+			continue;
+		}
+		for (const fs::directory_entry& entry : fs::recursive_directory_iterator(argv[i])) {
+			if (!entry.is_regular_file()) continue;
+			std::string path = entry.path().generic_string();
+			std::string extension = entry.path().extension().string();
+			if (extension == ".png" || extension == ".tga") images.insert(path);
+			else if (extension == ".json" && entry.path().filename() != SAVE_FILE_NAME) dataFiles.insert(path);
+		}
+	}
+
+	// Images in the atlas are only ever drawn from their page
+	for (const std::string& path : dataFiles) {
+		if (fs::path(path).filename() != ATLAS_TABLE_NAME) continue;
+		std::ifstream file(path);
+		json table;
+		file >> table;
+		for (const auto& region : table["regions"].items()) {
+			images.erase(region.key());
+		}
+	}
+
+	std::vector<Asset> assets;
+	stbi_set_flip_vertically_on_load(1);
+	for (const std::string& path : images) {
+		Asset asset = { path, AssetType::TEXTURE, 0, 0, {} };
+		if (!loadImage(path, asset)) {
+			std::cerr << "Could not load " << path << std::endl;
+			continue;
+		}
+		assets.push_back(std::move(asset));
+	}
+	for (const std::string& path : dataFiles) {
+		Asset asset = { path, AssetType::DATA, 0, 0, {} };
+		if (!loadData(path, asset)) {
+			std::cerr << "Could not parse " << path << std::endl;
+			continue;
+		}
+		assets.push_back(std::move(asset));
+	}
+
+	// The asset data starts after the header and every record
+	size_t offset = sizeof(AssetArchiveHeader);
+	for (const Asset& asset : assets) {
+		offset += sizeof(AssetArchiveRecord) + asset.path.size();
+	}
+
+	std::ofstream file(output, std::ios::binary);
+	if (!file.is_open()) {
+		std::cerr << "Could not write " << output << std::endl;
+		return 1;
+	}
+
+	AssetArchiveHeader header = {};
+	std::memcpy(header.magic, ASSET_ARCHIVE_MAGIC, 4);
+	header.version = ASSET_ARCHIVE_VERSION;
+	header.count = static_cast<uint32_t>(assets.size());
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	std::vector<size_t> offsets;
+	for (const Asset& asset : assets) {
+		offset = align(offset);
+		offsets.push_back(offset);
+		AssetArchiveRecord record = { offset, asset.data.size(), static_cast<uint32_t>(asset.type),
+			asset.width, asset.height, static_cast<uint32_t>(asset.path.size()) };
+		file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+		file.write(asset.path.data(), asset.path.size());
+		offset += asset.data.size();
+	}
+
+	const char padding[ASSET_ARCHIVE_ALIGNMENT] = { 0 };
+	for (unsigned int i = 0; i < assets.size(); ++i) {
+		size_t position = static_cast<size_t>(file.tellp());
+		file.write(padding, offsets[i] - position);
+		file.write(reinterpret_cast<const char*>(assets[i].data.data()), assets[i].data.size());
+	}
+
+	std::cout << "Packed " << assets.size() << " assets into " << output << " (" << offset / 1024 << " KB)" << std::endl;
+	return 0;
+}
@@ -0,0 +1,197 @@
+/*	Offline texture atlas packer
+		- Packs every png under the input directory into a few atlas pages and writes a
+			lookup table from the original file path to the page and sub rectangle
+		- The game loads the lookup table on startup, so sprites created from the original
+			paths are drawn from the atlas without any changes to the game code
+		- Images that are too big to share a page (backgrounds, cutscenes) are left out
+			and keep being loaded as loose textures
+
+	Usage:
+		AtlasPacker <input directory> <output directory>
+		e.g. AtlasPacker res/assets res/atlas, run from the repository root so the
+		paths in the lookup table match the paths used by the game
+*/
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image/stb_image.h>
+
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Width of every page, the height is cropped to whatever was used
+#define ATLAS_PAGE_SIZE		2048
+// Images bigger than this in either dimension are left as loose textures
+#define ATLAS_MAX_IMAGE_SIZE	512
+// Empty pixels between images so neighbours never bleed into each other
+#define ATLAS_PADDING		2
+// Name of the lookup table inside the output directory, has to match ATLAS_FILE in the engine
+#define ATLAS_TABLE_NAME	"atlas.json"
+
+struct Image {
+	std::string path;
+	int w, h;
+	unsigned char * data;
+	// Where the image was packed
+	int page, x, y;
+};
+
+struct Page {
+	std::vector<unsigned char> pixels;
+	int height;
+	// Current shelf of the page
+	int shelfX, shelfY, shelfHeight;
+};
+
+// Place an image on the current shelf of a page, starting a new shelf if it doesn't fit
+bool place(Page& page, Image& image) {
+	int w = image.w + ATLAS_PADDING;
+	int h = image.h + ATLAS_PADDING;
+	if (page.shelfX + w > ATLAS_PAGE_SIZE) {
+		page.shelfY += page.shelfHeight;
+		page.shelfX = 0;
+		page.shelfHeight = 0;
+	}
+	if (page.shelfY + h > ATLAS_PAGE_SIZE) return false;
+
+	image.x = page.shelfX;
+	image.y = page.shelfY;
+	page.shelfX += w;
+	page.shelfHeight = std::max(page.shelfHeight, h);
+	page.height = std::max(page.height, page.shelfY + page.shelfHeight);
+	return true;
+}
+
+void blit(Page& page, const Image& image) {
+	for (int row = 0; row < image.h; ++row) {
+		const unsigned char * src = image.data + row * image.w * 4;
+		unsigned char * dst = page.pixels.data() + ((image.y + row) * ATLAS_PAGE_SIZE + image.x) * 4;
+		std::copy(src, src + image.w * 4, dst);
+	}
+}
+
+// Write an uncompressed 32 bit tga, which stb_image can load without needing an encoder here
+bool writeTGA(const std::string& path, const Page& page) {
+	std::ofstream file(path, std::ios::binary);
+	if (!file.is_open()) return false;
+
+	unsigned char header[18] = { 0 };
+	header[2] = 2;	// Uncompressed true colour
+	header[12] = ATLAS_PAGE_SIZE & 0xFF;
+	header[13] = (ATLAS_PAGE_SIZE >> 8) & 0xFF;
+	header[14] = page.height & 0xFF;
+	header[15] = (page.height >> 8) & 0xFF;
+	header[16] = 32;
+	header[17] = 0x28;	// 8 alpha bits, rows are stored top to bottom
+	file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+	// Pixels are stored as BGRA
+	std::vector<unsigned char> row(ATLAS_PAGE_SIZE * 4);
+	for (int y = 0; y < page.height; ++y) {
+		const unsigned char * src = page.pixels.data() + y * ATLAS_PAGE_SIZE * 4;
+		for (int x = 0; x < ATLAS_PAGE_SIZE; ++x) {
+			row[x * 4 + 0] = src[x * 4 + 2];
+			row[x * 4 + 1] = src[x * 4 + 1];
+			row[x * 4 + 2] = src[x * 4 + 0];
+			row[x * 4 + 3] = src[x * 4 + 3];
+		}
+		file.write(reinterpret_cast<const char*>(row.data()), row.size());
+	}
+	return true;
+}
+
+int main(int argc, char * argv[]) {
+	if (argc < 3) {
+		std::cerr << "Usage: AtlasPacker <input directory> <output directory>" << std::endl;
+		return 1;
+	}
+	fs::path input(argv[1]);
+	fs::path output(argv[2]);
+
+	// Load every image that is small enough to pack
+	std::vector<Image> images;
+	std::vector<std::string> skipped;
+	for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input)) {
+		if (!entry.is_regular_file() || entry.path().extension() != ".png") continue;
+		std::string path = entry.path().generic_string();
+
+		Image image = { path, 0, 0, nullptr, -1, 0, 0 };
+		int channels;
+		if (!stbi_info(path.c_str(), &image.w, &image.h, &channels)) {
+			std::cerr << "Could not read " << path << std::endl;
+			continue;
+		}
+		if (image.w > ATLAS_MAX_IMAGE_SIZE || image.h > ATLAS_MAX_IMAGE_SIZE) {
+			skipped.push_back(path);
+			continue;
+		}
+		image.data = stbi_load(path.c_str(), &image.w, &image.h, &channels, 4);
+		if (!image.data) {
+			std::cerr << "Could not load " << path << std::endl;
+			continue;
+		}
+		images.push_back(image);
+	}
+
+	// Packing the tallest images first keeps the shelves tight, the path keeps the output stable
+	std::sort(images.begin(), images.end(), [](const Image& a, const Image& b) {
+		if (a.h != b.h) return a.h > b.h;
+		return a.path < b.path;
+	});
+
+	std::vector<Page> pages;
+	for (Image& image : images) {
+		for (unsigned int i = 0; i < pages.size() && image.page < 0; ++i) {
+			if (place(pages[i], image)) image.page = i;
+		}
+		if (image.page < 0) {
+			pages.push_back(Page{ std::vector<unsigned char>(ATLAS_PAGE_SIZE * ATLAS_PAGE_SIZE * 4, 0), 0, 0, 0, 0 });
+			place(pages.back(), image);
+			image.page = static_cast<int>(pages.size()) - 1;
+		}
+		blit(pages[image.page], image);
+		stbi_image_free(image.data);
+		image.data = nullptr;
+	}
+
+	fs::create_directories(output);
+	json table;
+	table["pages"] = json::array();
+	for (unsigned int i = 0; i < pages.size(); ++i) {
+		std::string pagePath = (output / ("page" + std::to_string(i) + ".tga")).generic_string();
+		if (!writeTGA(pagePath, pages[i])) {
+			std::cerr << "Could not write " << pagePath << std::endl;
+			return 1;
+		}
+		table["pages"].push_back(pagePath);
+	}
+	table["regions"] = json::object();
+	for (const Image& image : images) {
+		table["regions"][image.path] = {
+			{ "page", image.page },
+			{ "x", image.x },
+			{ "y", image.y },
+			{ "w", image.w },
+			{ "h", image.h }
+		};
+	}
+
+	std::ofstream file((output / ATLAS_TABLE_NAME).generic_string());
+	if (!file.is_open()) {
+		std::cerr << "Could not write the atlas lookup table" << std::endl;
+		return 1;
+	}
+	file << table.dump(4) << std::endl;
+
+	std::cout << "Packed " << images.size() << " images into " << pages.size() << " pages, "
+		<< skipped.size() << " images left loose" << std::endl;
+	return 0;
+}
@@ -0,0 +1,109 @@
+/*	Offline particle benchmark
+		- Measures how many particles per second every integration kernel the CPU supports
+			can move, with and without gravity
+		- Measures how the particle pool update scales from one thread to every core
+		- Links only the engine's particle code, so it runs without a window or GPU
+
+	Usage:
+		ParticleBenchmark
+*/
+
+#include "../src/engine/particleKernels.hpp"
+#include "../src/engine/particlePool.hpp"
+#include "../src/engine/particleWorkers.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Particles integrated by the kernel benchmark
+#define KERNEL_BENCHMARK_COUNT	100000
+// Particles updated by the thread scaling benchmark
+#define THREAD_BENCHMARK_COUNT	1000000
+// How long every configuration is run for
+#define BENCHMARK_TIME			0.25	// seconds
+
+typedef std::chrono::high_resolution_clock Clock;
+
+void benchmarkKernels() {
+	const size_t count = KERNEL_BENCHMARK_COUNT;
+	std::vector<float> x(count), y(count), previousX(count), previousY(count);
+	std::vector<float> velocityX(count), velocityY(count), gravity(count), maxY(count);
+	std::vector<int> age(count), lifespan(count);
+	ParticleStreams streams = { x.data(), y.data(), previousX.data(), previousY.data(),
+		velocityX.data(), velocityY.data(), gravity.data(), maxY.data(), age.data(), lifespan.data() };
+
+	for (int variant = 0; variant < 2; ++variant) {
+		bool falls = variant == 1;
+		for (int k = 0; k <= static_cast<int>(ParticleKernel::AVX2); ++k) {
+			ParticleKernel kernel = static_cast<ParticleKernel>(k);
+			if (!ParticleKernels::isSupported(kernel)) continue;
+
+			// Nothing dies or lands during the run, so every tick does the same work
+			for (size_t i = 0; i < count; ++i) {
+				x[i] = static_cast<float>(i % 1280);
+				y[i] = static_cast<float>(i % 720);
+				velocityX[i] = 0.5f;
+				velocityY[i] = -0.5f;
+				gravity[i] = falls ? 0.001f : 0.f;
+				maxY[i] = 1e9f;
+				age[i] = 0;
+				lifespan[i] = 1 << 30;
+			}
+
+			Clock::time_point start = Clock::now();
+			double elapsed = 0.0;
+			unsigned long long particles = 0;
+			bool dead = false;
+			while (elapsed < BENCHMARK_TIME) {
+				dead |= ParticleKernels::integrate(kernel, streams, count);
+				particles += count;
+				elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+			}
+			std::cout << "Particle kernel " << ParticleKernels::getName(kernel) << (falls ? " with gravity: " : " without gravity: ")
+				<< static_cast<unsigned long long>(particles / elapsed / 1000000.0) << " million particles per second"
+				<< (dead ? " (unexpected deaths)" : "") << std::endl;
+		}
+	}
+}
+
+void benchmarkThreads() {
+	ParticleWorkers& workers = ParticleWorkers::get_instance();
+	unsigned int maxThreads = workers.getThreadCount();
+	// Split even small pools so every thread count gets measured
+	workers.setThreshold(0);
+
+	ParticlePool pool;
+	std::vector<unsigned int> deaths;
+	double baseline = 0.0;
+	for (unsigned int threads = 1; threads <= maxThreads; ++threads) {
+		workers.setThreadCount(threads);
+
+		// Nothing dies during the run, so every tick does the same work
+		pool.resize(0);
+		for (size_t i = 0; i < THREAD_BENCHMARK_COUNT; ++i) {
+			pool.add(static_cast<float>(i % 1280), static_cast<float>(i % 720), 0.5f, -0.5f,
+				i % 2 ? 0.001f : 0.f, 1e9f, 1 << 30, 0);
+		}
+
+		Clock::time_point start = Clock::now();
+		double elapsed = 0.0;
+		unsigned long long particles = 0;
+		while (elapsed < BENCHMARK_TIME) {
+			pool.update(deaths);
+			particles += pool.size();
+			elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		}
+		double rate = particles / elapsed;
+		if (threads == 1) baseline = rate;
+		std::cout << "Particle update on " << threads << (threads == 1 ? " thread: " : " threads: ")
+			<< static_cast<unsigned long long>(rate / 1000000.0) << " million particles per second, "
+			<< rate / baseline << "x" << (deaths.empty() ? "" : " (unexpected deaths)") << std::endl;
+	}
+}
+
+int main() {
+	benchmarkKernels();
+	benchmarkThreads();
+	return 0;
+}